@@ -0,0 +1,96 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// A histogram of 2^20 keys counted with OpenMP atomics, as in
+/// tut_atomic-binning, and with ReduceArray<omp_reduce>, for few and many
+/// bins, with the keys spread over all of the bins or with most of them in
+/// one hot bin. Benchmark names end in /<bins>/<hot>.
+///
+
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#include "RAJA/RAJA.hpp"
+
+namespace
+{
+
+const int num_keys = 1 << 20;
+
+void histogram_args(benchmark::internal::Benchmark* b)
+{
+  for (int bins : {16, 4096, 1 << 20}) {
+    b->ArgPair(bins, 0);
+    b->ArgPair(bins, 1);
+  }
+}
+
+// with hot, nine keys in ten are bin 0
+std::vector<int> make_keys(int bins, bool hot)
+{
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> key(0, bins - 1);
+  std::uniform_int_distribution<int> tenth(0, 9);
+  std::vector<int> keys(num_keys);
+  for (int& k : keys) {
+    k = (hot && tenth(gen) != 0) ? 0 : key(gen);
+  }
+  return keys;
+}
+
+}  // closing brace for anonymous namespace
+
+static void benchmark_histogram_atomic(benchmark::State& state)
+{
+  const int bins = state.range(0);
+  const std::vector<int> keys = make_keys(bins, state.range(1) != 0);
+  std::vector<int> counts(bins);
+  const int* k = keys.data();
+  int* c = counts.data();
+  while (state.KeepRunning()) {
+    std::fill(counts.begin(), counts.end(), 0);
+    RAJA::forall<RAJA::omp_parallel_for_exec>(
+        RAJA::RangeSegment(0, num_keys), [=](int i) {
+          RAJA::atomic::atomicAdd<RAJA::atomic::omp_atomic>(&c[k[i]], 1);
+        });
+    benchmark::DoNotOptimize(c[0]);
+  }
+  state.SetItemsProcessed(state.iterations() * num_keys);
+}
+
+static void benchmark_histogram_reduce_array(benchmark::State& state)
+{
+  const int bins = state.range(0);
+  const std::vector<int> keys = make_keys(bins, state.range(1) != 0);
+  RAJA::ReduceArray<RAJA::omp_reduce, int> counts(bins);
+  const int* k = keys.data();
+  while (state.KeepRunning()) {
+    counts.reset(0);
+    RAJA::forall<RAJA::omp_parallel_for_exec>(
+        RAJA::RangeSegment(0, num_keys), [=](int i) { counts.add(k[i], 1); });
+    benchmark::DoNotOptimize(counts.get(0));
+  }
+  state.SetItemsProcessed(state.iterations() * num_keys);
+}
+
+BENCHMARK(benchmark_histogram_atomic)->Apply(histogram_args)->UseRealTime();
+BENCHMARK(benchmark_histogram_reduce_array)
+    ->Apply(histogram_args)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,159 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// Per-chunk dequeue cost of the lws statdynstaggered scheduler, compared
+/// with the per-thread queues protected by a pthread mutex that vSched used
+/// before they were made lock-free.
+///
+/// Every loop is fully dynamic (static fraction 0) and has an empty body,
+/// so items_per_second is the number of chunks handed out per second.
+///
+
+#include <pthread.h>
+#include <omp.h>
+
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#include "RAJA/RAJA.hpp"
+
+#define N (1 << 20)
+
+namespace
+{
+
+struct MutexWork {
+  int nextChunk;
+  int chunkSize;
+  int limit;
+  pthread_mutex_t qLock;
+};
+
+// The mutex-based dequeue, as it was in vSched.c.
+struct MutexScheduler {
+  std::vector<MutexWork> dynwork;
+  pthread_mutex_t sched_lock;
+  int count;
+
+  explicit MutexScheduler(int numThreads) : dynwork(numThreads), count(0)
+  {
+    pthread_mutex_init(&sched_lock, NULL);
+    for (auto& w : dynwork) {
+      pthread_mutex_init(&w.qLock, NULL);
+    }
+  }
+
+  ~MutexScheduler()
+  {
+    pthread_mutex_destroy(&sched_lock);
+    for (auto& w : dynwork) {
+      pthread_mutex_destroy(&w.qLock);
+    }
+  }
+
+  void start(int loopEnd, int tid, int numThreads, int chunkSize)
+  {
+    pthread_mutex_lock(&sched_lock);
+    if (count == 0) count = numThreads;
+    pthread_mutex_unlock(&sched_lock);
+    MutexWork& w = dynwork[tid];
+    pthread_mutex_lock(&w.qLock);
+    w.limit = (int)(((long long)loopEnd * (tid + 1)) / numThreads);
+    w.nextChunk = (int)(((long long)loopEnd * tid) / numThreads);
+    w.chunkSize = chunkSize;
+    pthread_mutex_unlock(&w.qLock);
+  }
+
+  int next(int* pstart, int* pend, int tid)
+  {
+    if (count == 0) return 0;
+    MutexWork& w = dynwork[tid];
+    pthread_mutex_lock(&w.qLock);
+    if (w.nextChunk < w.limit) {
+      *pstart = w.nextChunk;
+      w.nextChunk += w.chunkSize;
+      if (w.nextChunk > w.limit) w.nextChunk = w.limit;
+      *pend = w.nextChunk;
+      pthread_mutex_unlock(&w.qLock);
+      if (w.nextChunk >= w.limit) {
+        pthread_mutex_lock(&sched_lock);
+        count--;
+        pthread_mutex_unlock(&sched_lock);
+      }
+      return 1;
+    }
+    pthread_mutex_unlock(&w.qLock);
+    return 0;
+  }
+};
+
+}  // closing brace for anonymous namespace
+
+static void benchmark_dequeue_mutex(benchmark::State& state)
+{
+  const int numThreads = state.range(0);
+  const int chunkSize = state.range(1);
+  MutexScheduler sched(numThreads);
+
+  while (state.KeepRunning()) {
+#pragma omp parallel num_threads(numThreads)
+    {
+      int tid = omp_get_thread_num();
+      int start, end;
+      sched.start(N, tid, numThreads, chunkSize);
+#pragma omp barrier
+      while (sched.next(&start, &end, tid)) {
+        benchmark::DoNotOptimize(start);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (N / chunkSize));
+}
+
+static void benchmark_dequeue_lockfree(benchmark::State& state)
+{
+  const int numThreads = state.range(0);
+  const int chunkSize = state.range(1);
+  setStaticFraction(0.0, chunkSize);
+
+  while (state.KeepRunning()) {
+#pragma omp parallel num_threads(numThreads)
+    {
+      int tid = omp_get_thread_num();
+      int start, end;
+      loop_start_statdynstaggered(0, N, &start, &end, tid, numThreads);
+      while (loop_next_statdynstaggered(&start, &end, tid)) {
+        benchmark::DoNotOptimize(start);
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * (N / chunkSize));
+}
+
+static void dequeue_args(benchmark::internal::Benchmark* b)
+{
+  for (int threads = 1; threads <= omp_get_max_threads(); threads *= 2) {
+    for (int chunk : {1, 16}) {
+      b->Args({threads, chunk});
+    }
+  }
+}
+
+BENCHMARK(benchmark_dequeue_mutex)->Apply(dequeue_args)->UseRealTime();
+BENCHMARK(benchmark_dequeue_lockfree)->Apply(dequeue_args)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,127 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// Measures how the lws strategies and static fractions tolerate noise,
+/// with RAJA::lws::forall_with_noise holding up the chunks of a uniform loop:
+/// periodically, at random, or by slowing one thread down. The reported time
+/// is the makespan of the loop; the label gives the idle time of the threads
+/// as a share of makespan x threads, and the steals per loop. Benchmark names
+/// end in /<noise>/<static fraction in percent>, noise being 0 for none,
+/// 1 periodic, 2 random and 3 a slow thread.
+///
+
+#include <cstdio>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#include "RAJA/RAJA.hpp"
+
+namespace
+{
+
+const int loop_length = 1 << 16;
+const int chunk_size = 64;
+
+RAJA::lws::noise_model noise_of(int kind)
+{
+  switch (kind) {
+    case 1:
+      // 100 us every millisecond of work, as from a timer tick
+      return RAJA::lws::periodic_noise(1e-3, 100e-6, 1);
+    case 2:
+      // 200 us at random, once per millisecond of work on average
+      return RAJA::lws::random_noise(1e-3, 200e-6, 1);
+    case 3:
+      return RAJA::lws::slow_thread_noise(0, 2.0);
+    default:
+      return RAJA::lws::noise_model();
+  }
+}
+
+void noise_args(benchmark::internal::Benchmark* b)
+{
+  for (int kind = 0; kind < 4; ++kind) {
+    for (int fraction : {0, 50, 80, 100}) {
+      b->ArgPair(kind, fraction);
+    }
+  }
+}
+
+// static scheduling has no dynamic part
+void static_args(benchmark::internal::Benchmark* b)
+{
+  for (int kind = 0; kind < 4; ++kind) {
+    b->ArgPair(kind, 100);
+  }
+}
+
+}  // closing brace for anonymous namespace
+
+template <typename STRATEGY>
+static void benchmark_noise(benchmark::State& state)
+{
+  const RAJA::lws::noise_model noise = noise_of(state.range(0));
+  const float fraction = state.range(1) / 100.0f;
+  std::vector<double> out(loop_length);
+  double* o = out.data();
+  double idle = 0.0, capacity = 0.0;
+  long steals = 0;
+
+  while (state.KeepRunning()) {
+    const RAJA::lws::noise_report r =
+        RAJA::lws::forall_with_noise<STRATEGY>(
+            noise,
+            fraction,
+            chunk_size,
+            RAJA::RangeSegment(0, loop_length),
+            [=](int i) {
+              double x = i;
+              for (int k = 0; k < 64; ++k) {
+                x = x * 0.999 + 1.0;
+              }
+              o[i] = x;
+            });
+    state.SetIterationTime(r.makespan);
+    idle += r.idle;
+    capacity += r.makespan * r.threads;
+    steals += r.steals;
+  }
+
+  char label[64];
+  std::snprintf(label,
+                sizeof(label),
+                "idle=%.1f%% steals=%.1f",
+                capacity > 0.0 ? 100.0 * idle / capacity : 0.0,
+                static_cast<double>(steals) / state.iterations());
+  state.SetLabel(label);
+  state.SetItemsProcessed(state.iterations() * loop_length);
+}
+
+BENCHMARK_TEMPLATE(benchmark_noise, RAJA::lws::static_schedule)
+    ->Apply(static_args)
+    ->UseManualTime();
+BENCHMARK_TEMPLATE(benchmark_noise, RAJA::lws::static_fraction)
+    ->Apply(noise_args)
+    ->UseManualTime();
+BENCHMARK_TEMPLATE(benchmark_noise, RAJA::lws::statdynstaggered)
+    ->Apply(noise_args)
+    ->UseManualTime();
+BENCHMARK_TEMPLATE(benchmark_noise, RAJA::lws::guided)
+    ->Apply(noise_args)
+    ->UseManualTime();
+
+BENCHMARK_MAIN();
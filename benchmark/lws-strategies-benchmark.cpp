@@ -0,0 +1,166 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// Compares the lws scheduling strategies on the workloads of
+/// examples/jacobi.cpp (a Jacobi sweep over the rows of a grid) and
+/// appFor_vSchedSimple.c (a dot product), plus a dot product whose cost per
+/// iteration grows along the loop, which is where fixed-size chunks either
+/// leave threads idle at the end or pay for many dequeues. The last one also
+/// runs with omp_lws_weighted, given the cost of each iteration.
+///
+
+#include <cmath>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#include "RAJA/RAJA.hpp"
+
+namespace
+{
+
+// every dynamic strategy uses the same static fraction and (minimum) chunk
+using omp_static = RAJA::omp_parallel_for_lws<RAJA::lws::static_schedule>;
+using omp_fixed_chunks =
+    RAJA::omp_parallel_for_lws<RAJA::lws::static_fraction, 20, 8>;
+using omp_staggered =
+    RAJA::omp_parallel_for_lws<RAJA::lws::statdynstaggered, 20, 8>;
+using omp_guided = RAJA::omp_parallel_for_lws<RAJA::lws::guided, 20, 8>;
+using omp_factoring = RAJA::omp_parallel_for_lws<RAJA::lws::factoring, 20, 8>;
+using omp_trapezoid = RAJA::omp_parallel_for_lws<RAJA::lws::trapezoid, 20, 8>;
+
+}  // closing brace for anonymous namespace
+
+template <typename POLICY>
+static void benchmark_jacobi(benchmark::State& state)
+{
+  const int n = state.range(0);
+  const int rowLen = n + 2;
+  std::vector<double> I((n + 2) * rowLen, 0.0);
+  std::vector<double> Iold((n + 2) * rowLen, 0.0);
+  double* Inew = I.data();
+  const double* Icur = Iold.data();
+  const double h = 1.0 / (n + 1);
+
+  while (state.KeepRunning()) {
+    RAJA::forall<POLICY>(RAJA::RangeSegment(1, n + 1), [=](int m) {
+      const double y = m * h;
+      for (int k = 1; k <= n; ++k) {
+        const double x = k * h;
+        const double f = 2 * x * (y - 1) * (y - 2 * x + x * y + 2) * exp(x - y);
+        Inew[m * rowLen + k] =
+            0.25 * (-f * h * h + Icur[m * rowLen + k - 1]
+                    + Icur[m * rowLen + k + 1] + Icur[(m - 1) * rowLen + k]
+                    + Icur[(m + 1) * rowLen + k]);
+      }
+    });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * n);
+}
+
+template <typename POLICY>
+static void benchmark_dot_product(benchmark::State& state)
+{
+  const int n = state.range(0);
+  std::vector<float> a(n), b(n, 1.0f);
+  for (int i = 0; i < n; ++i) {
+    a[i] = i * 1.0f;
+  }
+  const float* pa = a.data();
+  const float* pb = b.data();
+
+  while (state.KeepRunning()) {
+    RAJA::ReduceSum<RAJA::omp_reduce, double> sum(0.0);
+    RAJA::forall<POLICY>(RAJA::RangeSegment(0, n),
+                         [=](int i) { sum += pa[i] * pb[i]; });
+    benchmark::DoNotOptimize(sum.get());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+template <typename POLICY>
+static void benchmark_dot_product_long_tail(benchmark::State& state)
+{
+  const int n = state.range(0);
+  std::vector<float> a(n), b(n, 1.0f);
+  for (int i = 0; i < n; ++i) {
+    a[i] = i * 1.0f;
+  }
+  const float* pa = a.data();
+  const float* pb = b.data();
+
+  while (state.KeepRunning()) {
+    RAJA::ReduceSum<RAJA::omp_reduce, double> sum(0.0);
+    RAJA::forall<POLICY>(RAJA::RangeSegment(0, n), [=](int i) {
+      // the cost of an iteration grows linearly with i
+      double x = 0.0;
+      for (int k = 0; k <= i / 64; ++k) {
+        x += std::sqrt(pa[i] + k) * std::sqrt(pb[i]);
+      }
+      sum += x;
+    });
+    benchmark::DoNotOptimize(sum.get());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+static void benchmark_dot_product_long_tail_weighted(benchmark::State& state)
+{
+  const int n = state.range(0);
+  std::vector<float> a(n), b(n, 1.0f);
+  std::vector<int> cost(n);
+  for (int i = 0; i < n; ++i) {
+    a[i] = i * 1.0f;
+    cost[i] = i / 64 + 1;
+  }
+  const float* pa = a.data();
+  const float* pb = b.data();
+
+  // the static fraction and chunk of the other policies
+  setStaticFraction(0.2f, 8);
+  while (state.KeepRunning()) {
+    RAJA::ReduceSum<RAJA::omp_reduce, double> sum(0.0);
+    RAJA::forall(RAJA::omp_lws_weighted<int>(
+                     RAJA::lws::iteration_costs(cost.data())),
+                 RAJA::RangeSegment(0, n),
+                 [=](int i) {
+                   double x = 0.0;
+                   for (int k = 0; k <= i / 64; ++k) {
+                     x += std::sqrt(pa[i] + k) * std::sqrt(pb[i]);
+                   }
+                   sum += x;
+                 });
+    benchmark::DoNotOptimize(sum.get());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+#define LWS_STRATEGY_BENCHMARKS(workload, ...)                 \
+  BENCHMARK_TEMPLATE(workload, omp_static)->__VA_ARGS__;       \
+  BENCHMARK_TEMPLATE(workload, omp_fixed_chunks)->__VA_ARGS__; \
+  BENCHMARK_TEMPLATE(workload, omp_staggered)->__VA_ARGS__;    \
+  BENCHMARK_TEMPLATE(workload, omp_guided)->__VA_ARGS__;       \
+  BENCHMARK_TEMPLATE(workload, omp_factoring)->__VA_ARGS__;    \
+  BENCHMARK_TEMPLATE(workload, omp_trapezoid)->__VA_ARGS__
+
+LWS_STRATEGY_BENCHMARKS(benchmark_jacobi, Arg(512)->UseRealTime());
+LWS_STRATEGY_BENCHMARKS(benchmark_dot_product, Arg(16384)->UseRealTime());
+LWS_STRATEGY_BENCHMARKS(benchmark_dot_product_long_tail,
+                        Arg(16384)->UseRealTime());
+BENCHMARK(benchmark_dot_product_long_tail_weighted)->Arg(16384)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,163 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// Measures the cost per loop of a timestep made of ten short lws loops
+/// (an axpy each), run as separate omp_lws loops, as omp_lws_for_exec loops
+/// in one parallel region, and as the loops of an omp_lws_region team with
+/// and without barriers. Items are loop iterations, so the time per item at
+/// small trip counts is mostly scheduling overhead.
+///
+/// It also times a step of ten Jacobi sweeps, each reading the neighbors of
+/// the one before, whose iterations get dearer along the range, so that
+/// threads finish each sweep at different times: as team loops with a
+/// barrier after each sweep, and as omp_lws_team_depend_exec<1> loops that
+/// only wait for the neighbors.
+///
+
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#include "RAJA/RAJA.hpp"
+
+namespace
+{
+
+const int loops_per_step = 10;
+
+struct step_data {
+  std::vector<double> x, y;
+  explicit step_data(int n) : x(n * loops_per_step, 1.0), y(x.size(), 0.0) {}
+};
+
+}  // closing brace for anonymous namespace
+
+static void benchmark_omp_lws_loops(benchmark::State& state)
+{
+  const int n = state.range(0);
+  step_data d(n);
+  const double* x = d.x.data();
+  double* y = d.y.data();
+
+  while (state.KeepRunning()) {
+    for (int l = 0; l < loops_per_step; ++l) {
+      RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(l * n, (l + 1) * n),
+                                  [=](int i) { y[i] += 2.0 * x[i]; });
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * loops_per_step);
+}
+
+static void benchmark_region_lws_for_exec(benchmark::State& state)
+{
+  const int n = state.range(0);
+  step_data d(n);
+  const double* x = d.x.data();
+  double* y = d.y.data();
+
+  while (state.KeepRunning()) {
+    RAJA::region<RAJA::omp_parallel_region>([=]() {
+      for (int l = 0; l < loops_per_step; ++l) {
+        RAJA::forall<RAJA::omp_lws_for_exec>(
+            RAJA::RangeSegment(l * n, (l + 1) * n),
+            [=](int i) { y[i] += 2.0 * x[i]; });
+      }
+    });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * loops_per_step);
+}
+
+template <typename POLICY>
+static void benchmark_lws_team(benchmark::State& state)
+{
+  const int n = state.range(0);
+  step_data d(n);
+  const double* x = d.x.data();
+  double* y = d.y.data();
+
+  while (state.KeepRunning()) {
+    RAJA::region<RAJA::omp_lws_region>([=]() {
+      for (int l = 0; l < loops_per_step; ++l) {
+        RAJA::forall<POLICY>(RAJA::RangeSegment(l * n, (l + 1) * n),
+                             [=](int i) { y[i] += 2.0 * x[i]; });
+      }
+    });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * loops_per_step);
+}
+
+template <typename POLICY>
+static void benchmark_lws_team_sweeps(benchmark::State& state)
+{
+  const int n = state.range(0);
+  std::vector<double> u(n + 2, 1.0), v(n + 2, 1.0);
+  double* pu = u.data();
+  double* pv = v.data();
+
+  while (state.KeepRunning()) {
+    RAJA::region<RAJA::omp_lws_region>([=]() {
+      for (int l = 0; l < loops_per_step; ++l) {
+        const double* from = (l % 2 == 0) ? pu : pv;
+        double* to = (l % 2 == 0) ? pv : pu;
+        RAJA::forall<POLICY>(RAJA::RangeSegment(1, n + 1), [=](int i) {
+          double sum = from[i - 1] + from[i + 1];
+          for (int k = 0; k < (8 * i) / n; ++k) {
+            sum = 0.5 * sum + 0.25 * from[i];
+          }
+          to[i] = 0.5 * sum;
+        });
+      }
+    });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n * loops_per_step);
+}
+
+BENCHMARK(benchmark_omp_lws_loops)
+    ->Arg(64)
+    ->Arg(1024)
+    ->Arg(16384)
+    ->UseRealTime();
+BENCHMARK(benchmark_region_lws_for_exec)
+    ->Arg(64)
+    ->Arg(1024)
+    ->Arg(16384)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_lws_team, RAJA::omp_lws_team_exec)
+    ->Arg(64)
+    ->Arg(1024)
+    ->Arg(16384)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_lws_team, RAJA::omp_lws_team_nowait_exec)
+    ->Arg(64)
+    ->Arg(1024)
+    ->Arg(16384)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(benchmark_lws_team_sweeps, RAJA::omp_lws_team_exec)
+    ->Arg(1024)
+    ->Arg(16384)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_lws_team_sweeps,
+                   RAJA::omp_lws_team_depend_exec<1>)
+    ->Arg(1024)
+    ->Arg(16384)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,80 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// Cost of recording the loop trace (RAJA::lws::write_trace), with tracing
+/// turned off and on at run time, for lws and OpenMP loops with an empty
+/// body and small chunks, where it is largest. Benchmark names end in
+/// /<chunk size>/<tracing>. Without ENABLE_LWS_TRACE both runs measure the
+/// loops with the recording compiled out.
+///
+
+#include <omp.h>
+
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#include "RAJA/RAJA.hpp"
+
+namespace
+{
+
+const int loop_length = 1 << 16;
+
+void trace_args(benchmark::internal::Benchmark* b)
+{
+  for (int chunk : {1, 16, 256}) {
+    b->ArgPair(chunk, 0);
+    b->ArgPair(chunk, 1);
+  }
+}
+
+template <typename POLICY>
+void run_traced(benchmark::State& state)
+{
+  setStaticFraction(0.5f, state.range(0));
+  RAJA::lws::set_tracing(state.range(1) != 0);
+  RAJA::lws::clear_trace();
+  std::vector<double> out(loop_length);
+  double* o = out.data();
+  while (state.KeepRunning()) {
+    RAJA::forall<POLICY>(RAJA::RangeSegment(0, loop_length),
+                         [=](int i) { o[i] = i; });
+    // keeps the buffers from filling up, after which chunks are only counted
+    RAJA::lws::clear_trace();
+  }
+  RAJA::lws::set_tracing(true);
+  state.SetLabel(RAJA::lws::trace_enabled ? "" : "trace compiled out");
+  state.SetItemsProcessed(state.iterations() * loop_length);
+}
+
+}  // closing brace for anonymous namespace
+
+static void benchmark_trace_lws(benchmark::State& state)
+{
+  run_traced<RAJA::omp_lws>(state);
+}
+
+// the OpenMP loop is traced per iteration; its chunk size is the runtime's
+static void benchmark_trace_omp_for(benchmark::State& state)
+{
+  run_traced<RAJA::omp_parallel_for_exec>(state);
+}
+
+BENCHMARK(benchmark_trace_lws)->Apply(trace_args)->UseRealTime();
+BENCHMARK(benchmark_trace_omp_for)->Apply(trace_args)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,120 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// Cost of the OpenMP reducers in a loop that uses four of them, where the
+/// combining of the thread copies at the end of each loop is a large share
+/// of the time, the same four in one ReduceTuple, and a sum alone, where the
+/// exact accumulation of omp_reduce_reproducible is. Benchmark names end in
+/// /<loop length>.
+///
+
+#include "benchmark/benchmark_api.h"
+
+#include "RAJA/RAJA.hpp"
+
+template <typename REDUCE>
+static void benchmark_reducers(benchmark::State& state)
+{
+  const int len = state.range(0);
+  RAJA::ReduceSum<REDUCE, double> sum(0.0);
+  RAJA::ReduceMin<REDUCE, double> min(1e300);
+  RAJA::ReduceMax<REDUCE, double> max(-1e300);
+  RAJA::ReduceMaxLoc<REDUCE, double> maxloc(-1e300, -1);
+  double total = 0.0;
+  while (state.KeepRunning()) {
+    RAJA::forall<RAJA::omp_parallel_for_exec>(RAJA::RangeSegment(0, len),
+                                              [=](int i) {
+                                                const double x = i % 97;
+                                                sum += x;
+                                                min.min(x);
+                                                max.max(x);
+                                                maxloc.maxloc(x, i);
+                                              });
+    total += sum.get() + min.get() + max.get() + maxloc.get();
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations() * len);
+}
+
+static void benchmark_tuple(benchmark::State& state)
+{
+  const int len = state.range(0);
+  RAJA::ReduceTuple<RAJA::omp_reduce,
+                    RAJA::reduce::sum<double>,
+                    RAJA::reduce::min<double>,
+                    RAJA::reduce::max<double>,
+                    RAJA::reduce::maxloc<double>>
+      all;
+  double total = 0.0;
+  while (state.KeepRunning()) {
+    RAJA::forall<RAJA::omp_parallel_for_exec>(RAJA::RangeSegment(0, len),
+                                              [=](int i) {
+                                                const double x = i % 97;
+                                                all.reduce<0>(x);
+                                                all.reduce<1>(x);
+                                                all.reduce<2>(x);
+                                                all.reduce<3>(x, i);
+                                              });
+    total += all.get<0>() + all.get<1>() + all.get<2>() + all.get<3>();
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations() * len);
+}
+
+template <typename REDUCE>
+static void benchmark_sum(benchmark::State& state)
+{
+  const int len = state.range(0);
+  RAJA::ReduceSum<REDUCE, double> sum(0.0);
+  double total = 0.0;
+  while (state.KeepRunning()) {
+    RAJA::forall<RAJA::omp_parallel_for_exec>(
+        RAJA::RangeSegment(0, len), [=](int i) { sum += 1.0 / (i + 1); });
+    total += sum.get();
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations() * len);
+}
+
+BENCHMARK_TEMPLATE(benchmark_reducers, RAJA::omp_reduce)
+    ->Arg(256)
+    ->Arg(1 << 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_reducers, RAJA::omp_reduce_ordered)
+    ->Arg(256)
+    ->Arg(1 << 16)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(benchmark_reducers, RAJA::omp_reduce_reproducible)
+    ->Arg(256)
+    ->Arg(1 << 16)
+    ->UseRealTime();
+
+BENCHMARK(benchmark_tuple)
+    ->Arg(256)
+    ->Arg(1 << 16)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(benchmark_sum, RAJA::omp_reduce)
+    ->Arg(256)
+    ->Arg(1 << 16)
+    ->UseRealTime();
+BENCHMARK_TEMPLATE(benchmark_sum, RAJA::omp_reduce_reproducible)
+    ->Arg(256)
+    ->Arg(1 << 16)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,223 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// Compares the CPU forall policies (sequential, simd, OpenMP, lws and TBB,
+/// as far as they are enabled) on synthetic loops: every iteration doing the
+/// same work, work growing linearly along the loop, work drawn from a
+/// heavy-tailed distribution, and an empty body, which measures the cost of
+/// the policy alone. Each runs over trip counts from 2^8 to 2^20 and, for the
+/// parallel policies, over thread counts from 1 up to the maximum in powers of
+/// two; benchmark names end in /<trip count>/<threads>.
+///
+/// ctest runs it with --benchmark_out_format=json, to keep the results for
+/// comparison with later runs.
+///
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#include "RAJA/RAJA.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP)
+#include <omp.h>
+#endif
+
+namespace
+{
+
+// average work per iteration of the non-empty loops
+const int mean_work = 32;
+
+RAJA_INLINE double spin(int i, int work)
+{
+  double x = i;
+  for (int k = 0; k < work; ++k) {
+    x = x * 0.999 + 1.0;
+  }
+  return x;
+}
+
+///
+/// Pareto distributed work (shape 1.5) with a mean of about mean_work, the
+/// same for every run.
+///
+std::vector<int> heavy_tail_work(int n)
+{
+  std::mt19937 gen(4242);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+  const double shape = 1.5;
+  const double scale = mean_work * (shape - 1.0) / shape;
+  std::vector<int> work(n);
+  for (int& w : work) {
+    const double x = scale / std::pow(1.0 - uniform(gen), 1.0 / shape);
+    w = static_cast<int>(std::min(x, 65536.0));
+  }
+  return work;
+}
+
+///
+/// How to run a policy's loops on a given number of threads.
+///
+struct serial_threads {
+};
+struct omp_threads {
+};
+struct tbb_threads {
+};
+
+template <typename POLICY>
+using threads_of = typename std::conditional<
+    RAJA::type_traits::is_openmp_policy<POLICY>::value,
+    omp_threads,
+    typename std::conditional<RAJA::type_traits::is_tbb_policy<POLICY>::value,
+                              tbb_threads,
+                              serial_threads>::type>::type;
+
+template <typename F>
+void with_threads(serial_threads, int, F&& f)
+{
+  f();
+}
+
+#if defined(RAJA_ENABLE_OPENMP)
+template <typename F>
+void with_threads(omp_threads, int threads, F&& f)
+{
+  const int outer = omp_get_max_threads();
+  omp_set_num_threads(threads);
+  f();
+  omp_set_num_threads(outer);
+}
+#endif
+
+#if defined(RAJA_ENABLE_TBB)
+template <typename F>
+void with_threads(tbb_threads, int threads, F&& f)
+{
+  tbb::task_arena arena(threads);
+  arena.execute(f);
+}
+#endif
+
+template <typename POLICY, typename Body>
+void run_loops(benchmark::State& state, Body body)
+{
+  const int n = state.range(0);
+  with_threads(threads_of<POLICY>{}, state.range(1), [&]() {
+    while (state.KeepRunning()) {
+      RAJA::forall<POLICY>(RAJA::RangeSegment(0, n), body);
+      benchmark::ClobberMemory();
+    }
+  });
+  state.SetItemsProcessed(state.iterations() * n);
+}
+
+const int trip_counts[] = {1 << 8, 1 << 12, 1 << 16, 1 << 20};
+
+void serial_args(benchmark::internal::Benchmark* b)
+{
+  for (int n : trip_counts) {
+    b->ArgPair(n, 1);
+  }
+}
+
+int max_threads()
+{
+#if defined(RAJA_ENABLE_OPENMP)
+  return omp_get_max_threads();
+#elif defined(RAJA_ENABLE_TBB)
+  return tbb::this_task_arena::max_concurrency();
+#else
+  return 1;
+#endif
+}
+
+void parallel_args(benchmark::internal::Benchmark* b)
+{
+  const int most = max_threads();
+  for (int n : trip_counts) {
+    for (int t = 1; t < most; t *= 2) {
+      b->ArgPair(n, t);
+    }
+    b->ArgPair(n, most);
+  }
+}
+
+}  // closing brace for anonymous namespace
+
+template <typename POLICY>
+static void benchmark_uniform(benchmark::State& state)
+{
+  std::vector<double> out(state.range(0));
+  double* o = out.data();
+  run_loops<POLICY>(state, [=](int i) { o[i] = spin(i, mean_work); });
+}
+
+template <typename POLICY>
+static void benchmark_linear(benchmark::State& state)
+{
+  const int n = state.range(0);
+  std::vector<double> out(n);
+  double* o = out.data();
+  run_loops<POLICY>(state, [=](int i) {
+    o[i] = spin(i, static_cast<int>((2L * mean_work * i) / n));
+  });
+}
+
+template <typename POLICY>
+static void benchmark_heavy_tail(benchmark::State& state)
+{
+  const std::vector<int> work = heavy_tail_work(state.range(0));
+  std::vector<double> out(work.size());
+  const int* w = work.data();
+  double* o = out.data();
+  run_loops<POLICY>(state, [=](int i) { o[i] = spin(i, w[i]); });
+}
+
+template <typename POLICY>
+static void benchmark_empty(benchmark::State& state)
+{
+  run_loops<POLICY>(state, [=](int) {});
+}
+
+#define SCHEDULER_BENCHMARKS(POLICY, ARGS)                                   \
+  BENCHMARK_TEMPLATE(benchmark_uniform, POLICY)->Apply(ARGS)->UseRealTime(); \
+  BENCHMARK_TEMPLATE(benchmark_linear, POLICY)->Apply(ARGS)->UseRealTime();  \
+  BENCHMARK_TEMPLATE(benchmark_heavy_tail, POLICY)                           \
+      ->Apply(ARGS)                                                          \
+      ->UseRealTime();                                                       \
+  BENCHMARK_TEMPLATE(benchmark_empty, POLICY)->Apply(ARGS)->UseRealTime()
+
+SCHEDULER_BENCHMARKS(RAJA::seq_exec, serial_args);
+SCHEDULER_BENCHMARKS(RAJA::simd_exec, serial_args);
+
+#if defined(RAJA_ENABLE_OPENMP)
+SCHEDULER_BENCHMARKS(RAJA::omp_parallel_for_exec, parallel_args);
+SCHEDULER_BENCHMARKS(RAJA::omp_parallel_for_static<16>, parallel_args);
+SCHEDULER_BENCHMARKS(RAJA::omp_lws, parallel_args);
+#endif
+
+#if defined(RAJA_ENABLE_TBB)
+SCHEDULER_BENCHMARKS(RAJA::tbb_for_exec, parallel_args);
+SCHEDULER_BENCHMARKS(RAJA::tbb_for_dynamic, parallel_args);
+#endif
+
+BENCHMARK_MAIN();
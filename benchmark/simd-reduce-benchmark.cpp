@@ -0,0 +1,90 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// A dot product and a max norm with seq_reduce reducers on one thread,
+/// with the loop policies that vectorize or don't. With loop_exec and
+/// simd_exec every iteration updates the same accumulator; simd_lanes_exec
+/// gives each lane its own. Benchmark names end in /<vector length>.
+///
+
+#include <cmath>
+#include <vector>
+
+#include "benchmark/benchmark_api.h"
+
+#include "RAJA/RAJA.hpp"
+
+template <typename POLICY>
+static void benchmark_dot(benchmark::State& state)
+{
+  const int len = state.range(0);
+  std::vector<double> xv(len, 1.0001), yv(len, 0.999);
+  const double* x = xv.data();
+  const double* y = yv.data();
+  double total = 0.0;
+  while (state.KeepRunning()) {
+    RAJA::ReduceSum<RAJA::seq_reduce, double> dot(0.0);
+    RAJA::forall<POLICY>(RAJA::RangeSegment(0, len),
+                         [=](int i) { dot += x[i] * y[i]; });
+    total += dot.get();
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations() * len);
+}
+
+template <typename POLICY>
+static void benchmark_max_norm(benchmark::State& state)
+{
+  const int len = state.range(0);
+  std::vector<double> xv(len);
+  for (int i = 0; i < len; ++i) {
+    xv[i] = std::sin(i);
+  }
+  const double* x = xv.data();
+  double total = 0.0;
+  while (state.KeepRunning()) {
+    RAJA::ReduceMax<RAJA::seq_reduce, double> norm(0.0);
+    RAJA::forall<POLICY>(RAJA::RangeSegment(0, len),
+                         [=](int i) { norm.max(std::fabs(x[i])); });
+    total += norm.get();
+  }
+  benchmark::DoNotOptimize(total);
+  state.SetItemsProcessed(state.iterations() * len);
+}
+
+BENCHMARK_TEMPLATE(benchmark_dot, RAJA::loop_exec)->Arg(1024)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(benchmark_dot, RAJA::simd_exec)->Arg(1024)->Arg(1 << 16);
+BENCHMARK_TEMPLATE(benchmark_dot, RAJA::simd_lanes_exec<4>)
+    ->Arg(1024)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(benchmark_dot, RAJA::simd_lanes_exec<8>)
+    ->Arg(1024)
+    ->Arg(1 << 16);
+
+BENCHMARK_TEMPLATE(benchmark_max_norm, RAJA::loop_exec)
+    ->Arg(1024)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(benchmark_max_norm, RAJA::simd_exec)
+    ->Arg(1024)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(benchmark_max_norm, RAJA::simd_lanes_exec<4>)
+    ->Arg(1024)
+    ->Arg(1 << 16);
+BENCHMARK_TEMPLATE(benchmark_max_norm, RAJA::simd_lanes_exec<8>)
+    ->Arg(1024)
+    ->Arg(1 << 16);
+
+BENCHMARK_MAIN();
@@ -39,6 +39,10 @@ macro(raja_add_executable)
     list (APPEND arg_DEPENDS_ON tbb)
   endif ()
 
+  if (ENABLE_LWS_THREADS)
+    list (APPEND arg_DEPENDS_ON lws_threads)
+  endif ()
+
   if (${arg_TEST})
     set (_output_dir ${CMAKE_BINARY_DIR}/test)
   elseif (${arg_BENCHMARK})
@@ -93,7 +97,10 @@ macro(raja_add_benchmark)
     DEPENDS_ON ${arg_DEPENDS_ON}
     BENCHMARK On)
 
+  # results go to benchmark/<name>.json, to compare runs
   blt_add_benchmark(
     NAME ${arg_NAME}
-    COMMAND ${TEST_DRIVER} ${arg_NAME})
+    COMMAND ${TEST_DRIVER} ${arg_NAME}
+      --benchmark_out_format=json
+      --benchmark_out=${CMAKE_BINARY_DIR}/benchmark/${arg_NAME}.json)
 endmacro(raja_add_benchmark)
@@ -37,6 +37,19 @@ if (ENABLE_TBB)
   endif()
 endif ()
 
+if (ENABLE_LWS_THREADS)
+  find_package(Threads)
+  if(Threads_FOUND)
+    blt_register_library(
+      NAME lws_threads
+      LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+    message(STATUS "lws std::thread backend Enabled")
+  else()
+    message(WARNING "Threads NOT FOUND")
+    set(ENABLE_LWS_THREADS Off)
+  endif()
+endif ()
+
 if (ENABLE_CHAI)
   message(STATUS "CHAI enabled")
   find_package(chai)
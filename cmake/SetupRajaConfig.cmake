@@ -38,7 +38,7 @@ option(RAJA_REPORT_FT "Report on use of fault-tolerant features" OFF)
 ## Timer options
 set(RAJA_TIMER "chrono" CACHE STRING
     "Select a timer backend")
-set_property(CACHE RAJA_TIMER PROPERTY STRINGS "chrono" "gettime" "clock" )
+set_property(CACHE RAJA_TIMER PROPERTY STRINGS "chrono" "gettime" "clock" "cycle" )
 
 if (RAJA_TIMER STREQUAL "chrono")
     set(RAJA_USE_CHRONO  ON  CACHE BOOL "Use the default std::chrono timer" )
@@ -55,6 +55,11 @@ if (RAJA_TIMER STREQUAL "clock")
 else ()
     set(RAJA_USE_CLOCK   OFF CACHE BOOL "Use clock from time.h for timer"    )
 endif ()
+if (RAJA_TIMER STREQUAL "cycle")
+    set(RAJA_USE_CYCLE   ON CACHE BOOL "Use the processor cycle counter for timer" )
+else ()
+    set(RAJA_USE_CYCLE   OFF CACHE BOOL "Use the processor cycle counter for timer" )
+endif ()
 
 include(CheckFunctionExists)
 check_function_exists(posix_memalign RAJA_HAVE_POSIX_MEMALIGN)
@@ -65,10 +70,13 @@ check_function_exists(_mm_malloc RAJA_HAVE_MM_MALLOC)
 set(RAJA_ENABLE_OPENMP ${ENABLE_OPENMP})
 set(RAJA_ENABLE_TARGET_OPENMP ${ENABLE_TARGET_OPENMP})
 set(RAJA_ENABLE_TBB ${ENABLE_TBB})
+set(RAJA_ENABLE_LWS_THREADS ${ENABLE_LWS_THREADS})
 set(RAJA_ENABLE_CUDA ${ENABLE_CUDA})
 set(RAJA_ENABLE_CLANG_CUDA ${ENABLE_CLANG_CUDA})
 set(RAJA_ENABLE_CHAI ${ENABLE_CHAI})
 set(RAJA_ENABLE_CUB ${ENABLE_CUB})
+set(RAJA_ENABLE_LWS_STATS ${ENABLE_LWS_STATS})
+set(RAJA_ENABLE_LWS_TRACE ${ENABLE_LWS_TRACE})
 
 # Configure a header file with all the variables we found.
 configure_file(${PROJECT_SOURCE_DIR}/include/RAJA/config.hpp.in
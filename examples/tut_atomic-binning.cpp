@@ -32,6 +32,7 @@
  *  RAJA features shown:
  *    - `forall` loop iteration template method
  *    - Atomic add
+ *    - ReduceArray, which counts into private bins instead
  *
  *  If CUDA is enabled, CUDA unified memory is used.
  */
@@ -80,6 +81,21 @@ int main(int RAJA_UNUSED_ARG(argc), char** RAJA_UNUSED_ARG(argv[]))
 
   printBins(bins, M);
 
+//----------------------------------------------------------------------------//
+
+  std::cout << "\n\n Running RAJA sequential binning with ReduceArray"
+            << std::endl;
+
+  RAJA::ReduceArray<RAJA::seq_reduce, int> seq_counts(M);
+
+  RAJA::forall<EXEC_POL1>(array_range, [=](int i) {
+
+      seq_counts.add(array[i], 1);
+
+    });
+
+  printBins(seq_counts.get().data(), M);
+
 //----------------------------------------------------------------------------//
 
 #if defined(RAJA_ENABLE_OPENMP)
@@ -114,6 +130,25 @@ int main(int RAJA_UNUSED_ARG(argc), char** RAJA_UNUSED_ARG(argv[]))
 
   printBins(bins, M);
 
+//----------------------------------------------------------------------------//
+
+  //
+  // Each thread counts into bins of its own, which are added up when the
+  // loop ends, so the threads don't contend for the bins as they do with
+  // atomics.
+  //
+  std::cout << "\n\n Running RAJA OMP binning with ReduceArray" << std::endl;
+
+  RAJA::ReduceArray<RAJA::omp_reduce, int> omp_counts(M);
+
+  RAJA::forall<EXEC_POL2>(array_range, [=](int i) {
+
+      omp_counts.add(array[i], 1);
+
+    });
+
+  printBins(omp_counts.get().data(), M);
+
 #endif
 //----------------------------------------------------------------------------//
 
@@ -25,7 +25,7 @@
  *  Reduction Example
  *
  *  This example illustrates use of the RAJA reduction types: min, max,
- *  sum, min-loc, and max-loc.
+ *  sum, min-loc, and max-loc, and of ReduceTuple, which holds several.
  *
  *  RAJA features shown:
  *    - `forall` loop iteration template method
@@ -159,6 +159,37 @@ int main(int RAJA_UNUSED_ARG(argc), char** RAJA_UNUSED_ARG(argv[]))
                                << omp_minloc.getLoc() << std::endl;
   std::cout << "\tmax, loc = " << omp_maxloc.get() << " , "
                                << omp_maxloc.getLoc() << std::endl; 
+
+//
+// The same reductions with one reducer object, which each thread copies
+// and combines once instead of five times.
+//
+  std::cout << "\n Running RAJA OpenMP reductions with ReduceTuple...\n";
+
+  RAJA::ReduceTuple<REDUCE_POL2,
+                    RAJA::reduce::sum<int>,
+                    RAJA::reduce::min<int>,
+                    RAJA::reduce::max<int>,
+                    RAJA::reduce::minloc<int>,
+                    RAJA::reduce::maxloc<int>> omp_all;
+
+  RAJA::forall<EXEC_POL2>(arange, [=](int i) {
+
+    omp_all.reduce<0>(a[i]);
+    omp_all.reduce<1>(a[i]);
+    omp_all.reduce<2>(a[i]);
+    omp_all.reduce<3>(a[i], i);
+    omp_all.reduce<4>(a[i], i);
+
+  });
+
+  std::cout << "\tsum = " << omp_all.get<0>() << std::endl;
+  std::cout << "\tmin = " << omp_all.get<1>() << std::endl;
+  std::cout << "\tmax = " << omp_all.get<2>() << std::endl;
+  std::cout << "\tmin, loc = " << omp_all.get<3>() << " , "
+                               << omp_all.get<3>().getLoc() << std::endl;
+  std::cout << "\tmax, loc = " << omp_all.get<4>() << " , "
+                               << omp_all.get<4>().getLoc() << std::endl;
 #endif
 
 
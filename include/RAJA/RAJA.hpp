@@ -84,6 +84,10 @@
 #include "RAJA/policy/openmp.hpp"
 #endif
 
+#if defined(RAJA_ENABLE_LWS_THREADS)
+#include "RAJA/policy/lws.hpp"
+#endif
+
 #include "RAJA/index/IndexSet.hpp"
 
 //
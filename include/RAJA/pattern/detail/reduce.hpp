@@ -26,6 +26,8 @@
 #ifndef RAJA_PATTERN_DETAIL_REDUCE_HPP
 #define RAJA_PATTERN_DETAIL_REDUCE_HPP
 
+#include "camp/camp.hpp"
+
 #include "RAJA/util/Operators.hpp"
 #include "RAJA/util/types.hpp"
 
@@ -39,12 +41,23 @@
     using Base::Base;                                         \
   };
 
+#define RAJA_DECLARE_TUPLE_REDUCER(POL, COMBINER)                    \
+  template <typename... Ops>                                         \
+  class ReduceTuple<POL, Ops...>                                     \
+      : public reduce::detail::BaseReduceTuple<COMBINER, Ops...>     \
+  {                                                                  \
+  public:                                                            \
+    using Base = reduce::detail::BaseReduceTuple<COMBINER, Ops...>;  \
+    using Base::Base;                                                \
+  };
+
 #define RAJA_DECLARE_ALL_REDUCERS(POL, COMBINER) \
   RAJA_DECLARE_REDUCER(Sum, POL, COMBINER)       \
   RAJA_DECLARE_REDUCER(Min, POL, COMBINER)       \
   RAJA_DECLARE_REDUCER(Max, POL, COMBINER)       \
   RAJA_DECLARE_REDUCER(MinLoc, POL, COMBINER)    \
-  RAJA_DECLARE_REDUCER(MaxLoc, POL, COMBINER)
+  RAJA_DECLARE_REDUCER(MaxLoc, POL, COMBINER)    \
+  RAJA_DECLARE_TUPLE_REDUCER(POL, COMBINER)
 
 namespace RAJA
 {
@@ -62,6 +75,7 @@ namespace detail
 template <typename T, template <typename...> class Op>
 struct op_adapter : private Op<T, T, T> {
   using operator_type = Op<T, T, T>;
+  using value_type = T;
   RAJA_HOST_DEVICE static constexpr T identity()
   {
     return operator_type::identity();
@@ -137,6 +151,18 @@ struct limits<::RAJA::reduce::detail::ValueLoc<T, B>> : limits<T> {
 namespace reduce
 {
 
+//! the operations of ReduceTuple that also keep an index
+template <typename T>
+using minloc = min<detail::ValueLoc<T>>;
+
+template <typename T>
+using maxloc = max<detail::ValueLoc<T, false>>;
+
+}  // end reduce
+
+namespace reduce
+{
+
 namespace detail
 {
 
@@ -417,6 +443,122 @@ public:
   operator T() const { return Base::get(); }
 };
 
+/*!
+ **************************************************************************
+ *
+ * \brief  The values of a ReduceTuple, one per operation.
+ *
+ **************************************************************************
+ */
+template <typename... Ops>
+struct TupleValue {
+  using tuple_type = camp::tuple<typename Ops::value_type...>;
+  tuple_type values;
+};
+
+template <typename Seq, typename... Ops>
+struct tuple_op_impl;
+
+template <camp::idx_t... Is, typename... Ops>
+struct tuple_op_impl<camp::idx_seq<Is...>, Ops...> {
+  using value_type = TupleValue<Ops...>;
+
+  static value_type identity()
+  {
+    return value_type{typename value_type::tuple_type(Ops::identity()...)};
+  }
+
+  static void apply(value_type &val, const value_type &v)
+  {
+    camp::sink(
+        (Ops{}(camp::get<Is>(val.values), camp::get<Is>(v.values)), 0)...);
+  }
+
+  static bool differ(const value_type &a, const value_type &b)
+  {
+    const bool differs[] = {
+        false, (camp::get<Is>(a.values) != camp::get<Is>(b.values))...};
+    for (bool d : differs) {
+      if (d) {
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+template <typename... Ops>
+using tuple_op = tuple_op_impl<camp::make_idx_seq_t<sizeof...(Ops)>, Ops...>;
+
+template <typename... Ops>
+bool operator!=(const TupleValue<Ops...> &a, const TupleValue<Ops...> &b)
+{
+  return tuple_op<Ops...>::differ(a, b);
+}
+
+//! reduces the values of a ReduceTuple, operation by operation
+template <typename Value>
+struct tuple_reduce;
+
+template <typename... Ops>
+struct tuple_reduce<TupleValue<Ops...>> {
+  static TupleValue<Ops...> identity() { return tuple_op<Ops...>::identity(); }
+
+  void operator()(TupleValue<Ops...> &val, const TupleValue<Ops...> v) const
+  {
+    tuple_op<Ops...>::apply(val, v);
+  }
+};
+
+/*!
+ **************************************************************************
+ *
+ * \brief  Reducer class template for several values reduced together,
+ *         each with its own operation, so a loop copies and combines one
+ *         reducer instead of one per value.
+ *
+ **************************************************************************
+ */
+template <template <typename, typename> class Combiner, typename... Ops>
+class BaseReduceTuple
+    : public BaseReduce<TupleValue<Ops...>, tuple_reduce, Combiner>
+{
+public:
+  using Base = BaseReduce<TupleValue<Ops...>, tuple_reduce, Combiner>;
+  using value_type = typename Base::value_type;
+
+  template <camp::idx_t I>
+  using element_type =
+      camp::tuple_element_t<I, typename value_type::tuple_type>;
+
+  //! starts every value at the identity of its operation
+  BaseReduceTuple() : Base(tuple_reduce<value_type>::identity()) {}
+
+  explicit BaseReduceTuple(typename Ops::value_type... init_vals)
+      : Base(value_type{typename value_type::tuple_type(init_vals...)})
+  {
+  }
+
+  //! reducer function; reduces value I with an element built from args
+  template <camp::idx_t I, typename... Args>
+  const BaseReduceTuple &reduce(Args &&... args) const
+  {
+    using Op = camp::tuple_element_t<I, camp::tuple<Ops...>>;
+    Op{}(camp::get<I>(this->local().values),
+         element_type<I>(std::forward<Args>(args)...));
+    return *this;
+  }
+
+  using Base::get;
+
+  //! Get the calculated reduced value I
+  template <camp::idx_t I>
+  element_type<I> get() const
+  {
+    return camp::get<I>(Base::get().values);
+  }
+};
+
 } /* detail */
 
 } /* reduce */
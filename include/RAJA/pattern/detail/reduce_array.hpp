@@ -0,0 +1,234 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief  Base types for ReduceArray, a reducer summing into an array of
+ *         bins, as a histogram does.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_PATTERN_DETAIL_REDUCE_ARRAY_HPP
+#define RAJA_PATTERN_DETAIL_REDUCE_ARRAY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "RAJA/util/types.hpp"
+
+#define RAJA_DECLARE_ARRAY_REDUCER(POL, IMPL)  \
+  template <typename T>                        \
+  class ReduceArray<POL, T> : public IMPL<T>   \
+  {                                            \
+  public:                                      \
+    using Base = IMPL<T>;                      \
+    using Base::Base;                          \
+  };
+
+namespace RAJA
+{
+
+namespace reduce
+{
+
+namespace detail
+{
+
+/*!
+ **************************************************************************
+ *
+ * \brief  ReduceArray for sequential execution: every copy adds straight
+ *         into the bins of the reducer it was made from.
+ *
+ **************************************************************************
+ */
+template <typename T>
+class ReduceArrayShared
+{
+public:
+  explicit ReduceArrayShared(Index_type bins, T init_val = T())
+      : m_bins(bins), m_storage(new T[bins]), m_values(m_storage.get())
+  {
+    reset(init_val);
+  }
+
+  ReduceArrayShared(const ReduceArrayShared& other)
+      : m_bins(other.m_bins), m_values(other.m_values)
+  {
+  }
+
+  ReduceArrayShared& operator=(const ReduceArrayShared&) = delete;
+
+  //! reducer function; adds value to bin
+  const ReduceArrayShared& add(Index_type bin, T value) const
+  {
+    m_values[bin] += value;
+    return *this;
+  }
+
+  void reset(T init_val) { std::fill(m_values, m_values + m_bins, init_val); }
+
+  Index_type size() const { return m_bins; }
+
+  //! Get the calculated reduced value of bin
+  T get(Index_type bin) const { return m_values[bin]; }
+
+  //! Get the calculated reduced values of all the bins
+  std::vector<T> get() const
+  {
+    return std::vector<T>(m_values, m_values + m_bins);
+  }
+
+private:
+  Index_type m_bins;
+  std::unique_ptr<T[]> m_storage;  // only in the reducer the copies share
+  T* m_values;
+};
+
+/*!
+ **************************************************************************
+ *
+ * \brief  ReduceArray for threads: each copy adds into private bins, which
+ *         it merges into the bins of the reducer it was made from when it
+ *         goes out of scope.
+ *
+ * The private bins come in blocks of block_bins, allocated when a bin of
+ * the block is first added to, so a copy only holds the blocks it
+ * touched, however many bins there are. Copies merge block by block, each
+ * block of the result under its own flag and each copy starting at a
+ * different block, so threads that finish together merge in parallel.
+ *
+ **************************************************************************
+ */
+template <typename T>
+class ReduceArrayPrivate
+{
+public:
+  static constexpr Index_type block_bins = 512;
+
+  explicit ReduceArrayPrivate(Index_type bins, T init_val = T())
+      : m_bins(bins), m_shared(new shared(bins))
+  {
+    reset(init_val);
+  }
+
+  ReduceArrayPrivate(const ReduceArrayPrivate& other)
+      : m_parent(other.m_parent ? other.m_parent : &other),
+        m_bins(other.m_bins)
+  {
+  }
+
+  ReduceArrayPrivate& operator=(const ReduceArrayPrivate&) = delete;
+
+  ~ReduceArrayPrivate()
+  {
+    if (m_parent && m_blocks) {
+      m_parent->m_shared->merge(m_blocks.get());
+    }
+  }
+
+  //! reducer function; adds value to bin
+  const ReduceArrayPrivate& add(Index_type bin, T value) const
+  {
+    if (!m_parent) {
+      m_shared->values[bin] += value;
+      return *this;
+    }
+    if (!m_blocks) {
+      m_blocks.reset(new std::unique_ptr<T[]>[m_parent->m_shared->blocks]);
+    }
+    std::unique_ptr<T[]>& block = m_blocks[bin / block_bins];
+    if (!block) {
+      block.reset(new T[block_bins]());
+    }
+    block[bin % block_bins] += value;
+    return *this;
+  }
+
+  void reset(T init_val)
+  {
+    if (m_shared) {
+      std::fill(m_shared->values.begin(), m_shared->values.end(), init_val);
+    }
+  }
+
+  Index_type size() const { return m_bins; }
+
+  //! Get the calculated reduced value of bin; call it between loops
+  T get(Index_type bin) const { return m_shared->values[bin]; }
+
+  //! Get the calculated reduced values of all the bins
+  std::vector<T> get() const { return m_shared->values; }
+
+private:
+  struct shared {
+    explicit shared(Index_type bins_)
+        : values(bins_),
+          bins(bins_),
+          blocks((bins_ + block_bins - 1) / block_bins),
+          busy(new std::atomic<bool>[blocks])
+    {
+      for (Index_type b = 0; b < blocks; ++b) {
+        busy[b].store(false, std::memory_order_relaxed);
+      }
+    }
+
+    void merge(const std::unique_ptr<T[]>* from)
+    {
+      const Index_type start =
+          next_start.fetch_add(1, std::memory_order_relaxed) % blocks;
+      for (Index_type k = 0; k < blocks; ++k) {
+        const Index_type b = (start + k) % blocks;
+        if (!from[b]) {
+          continue;
+        }
+        const Index_type first = b * block_bins;
+        const Index_type last = std::min(first + block_bins, bins);
+        while (busy[b].exchange(true, std::memory_order_acquire)) {
+        }
+        for (Index_type i = first; i < last; ++i) {
+          values[i] += from[b][i - first];
+        }
+        busy[b].store(false, std::memory_order_release);
+      }
+    }
+
+    std::vector<T> values;
+    Index_type bins;
+    Index_type blocks;
+    std::unique_ptr<std::atomic<bool>[]> busy;
+    std::atomic<Index_type> next_start{0};
+  };
+
+  const ReduceArrayPrivate* m_parent = nullptr;
+  Index_type m_bins;
+  // only the reducer the copies are made from has the result
+  std::unique_ptr<shared> m_shared;
+  mutable std::unique_ptr<std::unique_ptr<T[]>[]> m_blocks;
+};
+
+}  // end detail
+
+}  // end reduce
+
+}  // end RAJA
+
+#endif  // closing endif for header file include guard
@@ -0,0 +1,124 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief  Per-thread slots that the copies of a reducer combine into.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_PATTERN_DETAIL_REDUCE_SLOTS_HPP
+#define RAJA_PATTERN_DETAIL_REDUCE_SLOTS_HPP
+
+#include <atomic>
+#include <new>
+
+#include "RAJA/internal/MemUtils_CPU.hpp"
+
+namespace RAJA
+{
+
+namespace reduce
+{
+
+namespace detail
+{
+
+///
+/// The partial results of a CPU reducer, one slot per thread, each in a
+/// cache line of its own. The copies a thread made of the reducer combine
+/// into the slot of its thread number when they go out of scope, so threads
+/// never wait for each other; a slot's flag is only contended when two
+/// threads share the slot, because the team is larger than the count the
+/// slots were made for or two teams run at once.
+///
+template <typename T>
+class ReduceSlots
+{
+public:
+  ReduceSlots(int count, T identity)
+      : m_count(count > 0 ? count : 1),
+        m_slots(allocate_aligned_type<slot>(alignof(slot),
+                                            m_count * sizeof(slot)))
+  {
+    if (m_slots == nullptr) {
+      throw std::bad_alloc();
+    }
+    for (int t = 0; t < m_count; ++t) {
+      new (&m_slots[t]) slot(identity);
+    }
+  }
+
+  ReduceSlots(const ReduceSlots&) = delete;
+  ReduceSlots& operator=(const ReduceSlots&) = delete;
+
+  ~ReduceSlots()
+  {
+    for (int t = 0; t < m_count; ++t) {
+      m_slots[t].~slot();
+    }
+    free_aligned(m_slots);
+  }
+
+  template <typename Reduce>
+  void combine(int thread, const T& value)
+  {
+    slot& s = m_slots[thread % m_count];
+    while (s.busy.exchange(true, std::memory_order_acquire)) {
+    }
+    Reduce{}(s.value, value);
+    s.busy.store(false, std::memory_order_release);
+  }
+
+  //! combines every slot into value and empties it; call it between loops
+  template <typename Reduce>
+  void collect(T& value, const T& identity)
+  {
+    for (int t = 0; t < m_count; ++t) {
+      Reduce{}(value, m_slots[t].value);
+      m_slots[t].value = identity;
+    }
+  }
+
+  void reset(const T& identity)
+  {
+    for (int t = 0; t < m_count; ++t) {
+      m_slots[t].value = identity;
+    }
+  }
+
+private:
+  struct alignas(64) slot {
+    explicit slot(const T& identity) : busy(false), value(identity) {}
+
+    std::atomic<bool> busy;
+    T value;
+  };
+
+  int m_count;
+  slot* m_slots;
+};
+
+}  // closing brace for detail namespace
+
+}  // closing brace for reduce namespace
+
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for header file include guard
@@ -0,0 +1,345 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief  Accumulators for reductions whose result does not depend on the
+ *         order in which the values are combined, so it is the same for any
+ *         thread count or schedule.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_PATTERN_DETAIL_REPRODUCIBLE_HPP
+#define RAJA_PATTERN_DETAIL_REPRODUCIBLE_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "RAJA/util/macros.hpp"
+
+#include "RAJA/pattern/detail/reduce.hpp"
+
+namespace RAJA
+{
+
+namespace reduce
+{
+
+namespace detail
+{
+
+/*!
+ * \brief The exact sum of doubles, as a fixed-point number wide enough for
+ *        any of them, so adding is associative and the sum is rounded once,
+ *        to nearest, when it is read.
+ *
+ * The number is kept in limbs of 32 bits, from 2^-1074, the smallest
+ * subnormal, up; a limb is an int64_t so that additions can leave carries
+ * in it, which are only propagated every so often.
+ */
+class exact_sum
+{
+public:
+  void add(double x)
+  {
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(bits));
+    const int biased = static_cast<int>((bits >> 52) & 0x7ff);
+    std::uint64_t m = bits & ((std::uint64_t(1) << 52) - 1);
+    if (biased == 0x7ff) {
+      m_special |= (m != 0) ? nan_seen : (bits >> 63) ? minus_inf : plus_inf;
+      return;
+    }
+    if (biased != 0) {
+      m |= std::uint64_t(1) << 52;
+    }
+    if (m == 0) {
+      return;
+    }
+    // x is m * 2^(lsb - 1074), subnormals having the same lsb as the
+    // smallest normals
+    const int lsb = (biased != 0) ? biased - 1 : 0;
+    const int i = lsb / limb_bits;
+    const int s = lsb % limb_bits;
+    const std::uint64_t lo = (m & limb_mask) << s;
+    const std::uint64_t hi = (m >> limb_bits) << s;
+    const std::int64_t d0 = static_cast<std::int64_t>(lo & limb_mask);
+    const std::int64_t d1 =
+        static_cast<std::int64_t>((lo >> limb_bits) + (hi & limb_mask));
+    const std::int64_t d2 = static_cast<std::int64_t>(hi >> limb_bits);
+    if (bits >> 63) {
+      m_limb[i] -= d0;
+      m_limb[i + 1] -= d1;
+      m_limb[i + 2] -= d2;
+    } else {
+      m_limb[i] += d0;
+      m_limb[i + 1] += d1;
+      m_limb[i + 2] += d2;
+    }
+    if (++m_pending == max_pending) {
+      carry(m_limb);
+      m_pending = 0;
+    }
+  }
+
+  void add(const exact_sum& other)
+  {
+    carry(m_limb);
+    for (int k = 0; k < limbs; ++k) {
+      m_limb[k] += other.m_limb[k];
+    }
+    m_pending = other.m_pending + 1;
+    m_special |= other.m_special;
+  }
+
+  //! the sum rounded to nearest, ties to even
+  double get() const
+  {
+    if ((m_special & nan_seen)
+        || (m_special & (plus_inf | minus_inf)) == (plus_inf | minus_inf)) {
+      return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (m_special != 0) {
+      return (m_special & plus_inf) ? std::numeric_limits<double>::infinity()
+                                    : -std::numeric_limits<double>::infinity();
+    }
+
+    std::int64_t v[limbs];
+    std::memcpy(v, m_limb, sizeof(v));
+    carry(v);
+    const bool negative = v[limbs - 1] < 0;
+    if (negative) {
+      for (int k = 0; k < limbs; ++k) {
+        v[k] = -v[k];
+      }
+      carry(v);
+    }
+
+    int h = limbs - 1;
+    while (h >= 0 && v[h] == 0) {
+      --h;
+    }
+    if (h < 0) {
+      return 0.0;
+    }
+    if (h == limbs - 1) {
+      // 2^1038 or more
+      return negative ? -std::numeric_limits<double>::infinity()
+                      : std::numeric_limits<double>::infinity();
+    }
+
+    // the leading 64 bits, with a sticky bit for the ones below, so that
+    // converting them rounds as the whole sum would
+    std::uint64_t top = static_cast<std::uint64_t>(v[h]);
+    int exponent = h * limb_bits - 1074;
+    int k = h - 1;
+    while (k >= 0 && top <= limb_mask) {
+      top = (top << limb_bits) | static_cast<std::uint64_t>(v[k]);
+      exponent -= limb_bits;
+      --k;
+    }
+    if (k >= 0) {
+      int lz = 0;
+      while ((top << lz) >> 63 == 0) {
+        ++lz;
+      }
+      const std::uint64_t next = static_cast<std::uint64_t>(v[k]);
+      bool sticky = (next & (limb_mask >> lz)) != 0;
+      if (lz > 0) {
+        top = (top << lz) | (next >> (limb_bits - lz));
+        exponent -= lz;
+      }
+      for (--k; k >= 0 && !sticky; --k) {
+        sticky = v[k] != 0;
+      }
+      top |= sticky ? 1 : 0;
+    }
+    const double r = std::ldexp(static_cast<double>(top), exponent);
+    return negative ? -r : r;
+  }
+
+private:
+  static constexpr int limb_bits = 32;
+  static constexpr std::uint64_t limb_mask = 0xffffffff;
+  // up to 2^1038, past the largest double, which leaves the last limb for
+  // the carries out of the others
+  static constexpr int limbs = 67;
+  // an addition moves a limb by less than 2^33
+  static constexpr int max_pending = 1 << 29;
+
+  enum { plus_inf = 1, minus_inf = 2, nan_seen = 4 };
+
+  // leaves every limb but the last in [0, 2^32)
+  static void carry(std::int64_t* v)
+  {
+    for (int k = 0; k < limbs - 1; ++k) {
+      const std::int64_t low =
+          static_cast<std::int64_t>(static_cast<std::uint64_t>(v[k])
+                                    & limb_mask);
+      v[k + 1] += (v[k] - low) / (std::int64_t(1) << limb_bits);
+      v[k] = low;
+    }
+  }
+
+  std::int64_t m_limb[limbs] = {};
+  int m_pending = 0;
+  int m_special = 0;
+};
+
+//! whether a goes before b in a min (or max) reduction, -0.0 before 0.0
+template <typename T>
+RAJA_INLINE bool reproducible_before(const T& a, const T& b, bool doing_min)
+{
+  if (doing_min ? a < b : b < a) {
+    return true;
+  }
+  return a == b && std::signbit(a) != std::signbit(b)
+         && std::signbit(a) == doing_min;
+}
+
+//! equal values go to the lower index
+template <typename T, bool B>
+RAJA_INLINE bool reproducible_before(const ValueLoc<T, B>& a,
+                                     const ValueLoc<T, B>& b,
+                                     bool doing_min)
+{
+  if (reproducible_before(a.val, b.val, doing_min)) {
+    return true;
+  }
+  return !reproducible_before(b.val, a.val, doing_min) && a.loc < b.loc;
+}
+
+/*!
+ * \brief How a reproducible reducer accumulates the values of Reduce: in an
+ *        acc_type, which add() updates with a value and merge combines with
+ *        another, and which result() reads.
+ *
+ * This one is for the reductions whose result already does not depend on
+ * the order, integer sums among them.
+ */
+template <typename T, typename Reduce>
+struct reproducible {
+  using acc_type = T;
+  using merge = Reduce;
+
+  static acc_type make(const T& identity) { return identity; }
+
+  static void add(acc_type& acc, const T& value) { Reduce{}(acc, value); }
+
+  static T result(const acc_type& acc) { return acc; }
+};
+
+template <typename T>
+struct reproducible<T, sum<T>> {
+  static_assert(!std::is_floating_point<T>::value,
+                "reproducible sums are only for float, double and integers");
+
+  using acc_type = T;
+  using merge = sum<T>;
+
+  static acc_type make(const T& identity) { return identity; }
+
+  static void add(acc_type& acc, const T& value) { acc += value; }
+
+  static T result(const acc_type& acc) { return acc; }
+};
+
+//! floats are summed exactly as doubles, and the sum rounded to float
+template <typename T>
+struct reproducible_float_sum {
+  using acc_type = exact_sum;
+
+  struct merge {
+    void operator()(exact_sum& acc, const exact_sum& other) const
+    {
+      acc.add(other);
+    }
+  };
+
+  static acc_type make(const T& identity)
+  {
+    exact_sum acc;
+    acc.add(static_cast<double>(identity));
+    return acc;
+  }
+
+  static void add(acc_type& acc, const T& value)
+  {
+    acc.add(static_cast<double>(value));
+  }
+
+  static T result(const acc_type& acc) { return static_cast<T>(acc.get()); }
+};
+
+template <>
+struct reproducible<float, sum<float>> : reproducible_float_sum<float> {
+};
+
+template <>
+struct reproducible<double, sum<double>> : reproducible_float_sum<double> {
+};
+
+template <typename T, bool doing_min>
+struct reproducible_extreme {
+  using acc_type = T;
+
+  static acc_type make(const T& identity) { return identity; }
+
+  static void add(acc_type& acc, const T& value)
+  {
+    if (reproducible_before(value, acc, doing_min)) {
+      acc = value;
+    }
+  }
+
+  struct merge {
+    void operator()(acc_type& acc, const acc_type& other) const
+    {
+      add(acc, other);
+    }
+  };
+
+  static T result(const acc_type& acc) { return acc; }
+};
+
+//! ReduceTuple adds to its values in place, which an accumulator can't take
+template <typename... Ops>
+struct reproducible<TupleValue<Ops...>, tuple_reduce<TupleValue<Ops...>>> {
+  static_assert(sizeof...(Ops) == 0,
+                "ReduceTuple is not reproducible, use a reducer per value");
+};
+
+template <typename T>
+struct reproducible<T, min<T>> : reproducible_extreme<T, true> {
+};
+
+template <typename T>
+struct reproducible<T, max<T>> : reproducible_extreme<T, false> {
+};
+
+}  // end detail
+
+}  // end reduce
+
+}  // end RAJA
+
+#endif  // closing endif for header file include guard
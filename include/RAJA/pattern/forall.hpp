@@ -283,6 +283,32 @@ RAJA_INLINE void forall_Icount(ExecPolicy<SegmentIterPolicy, SegmentExecPolicy>,
   });
 }
 
+/*!
+******************************************************************************
+*
+* \brief Execute the segments of an index set, each with SegmentExecPolicy,
+*         as a loop over segment ids with SegmentIterPolicy.
+*
+*         Segment iteration policies that schedule the iterations of the
+*         segments themselves overload this for their policy; the overloads
+*         are found by ADL.
+*
+******************************************************************************
+*/
+template <typename SegmentIterPolicy,
+          typename SegmentExecPolicy,
+          typename LoopBody,
+          typename... SegmentTypes>
+RAJA_INLINE void forall_segments(SegmentIterPolicy,
+                                 SegmentExecPolicy,
+                                 const TypedIndexSet<SegmentTypes...>& iset,
+                                 LoopBody body)
+{
+  wrap::forall(SegmentIterPolicy(), iset, [=](int segID) {
+    iset.segmentCall(segID, detail::CallForall{}, SegmentExecPolicy(), body);
+  });
+}
+
 template <typename SegmentIterPolicy,
           typename SegmentExecPolicy,
           typename LoopBody,
@@ -295,9 +321,7 @@ RAJA_INLINE void forall(ExecPolicy<SegmentIterPolicy, SegmentExecPolicy>,
   using RAJA::internal::trigger_updates_before;
   auto body = trigger_updates_before(loop_body);
 
-  wrap::forall(SegmentIterPolicy(), iset, [=](int segID) {
-    iset.segmentCall(segID, detail::CallForall{}, SegmentExecPolicy(), body);
-  });
+  forall_segments(SegmentIterPolicy(), SegmentExecPolicy(), iset, body);
 }
 
 }  // end namespace wrap
@@ -188,6 +188,67 @@ class ReduceMaxLoc;
  */
 template <typename REDUCE_POLICY_T, typename T>
 class ReduceSum;
+
+/*!
+ ******************************************************************************
+ *
+ * \brief  Reducer class template for several values at once, each reduced
+ *         with its own operation: RAJA::reduce::sum, min, max, minloc or
+ *         maxloc of its type. The values are copied and combined together,
+ *         once per thread, which is cheaper than a reducer for each.
+ *
+ * Usage example:
+ *
+ * \verbatim
+
+   Real_ptr data = ...;
+   ReduceTuple<reduce_policy,
+               reduce::sum<Real_type>,
+               reduce::minloc<Real_type>> my_red(0.0, {init_val, -1});
+
+   forall<exec_policy>( ..., [=] (Index_type i) {
+      my_red.reduce<0>(data[i]);
+      my_red.reduce<1>(data[i], i);
+   }
+
+   Real_type sum = my_red.get<0>();
+   Index_type minloc = my_red.get<1>().getLoc();
+
+ * \endverbatim
+ *
+ ******************************************************************************
+ */
+template <typename REDUCE_POLICY_T, typename... Ops>
+class ReduceTuple;
+
+/*!
+ ******************************************************************************
+ *
+ * \brief  Reducer class template summing into an array of bins, for
+ *         histograms and other loops that would otherwise add to shared
+ *         bins with atomics. Threads add to private bins, which are merged
+ *         when the loop ends.
+ *
+ * Usage example:
+ *
+ * \verbatim
+
+   Index_type* keys = ...;
+   ReduceArray<reduce_policy, int> counts(num_bins);
+
+   forall<exec_policy>( ..., [=] (Index_type i) {
+      counts.add(keys[i], 1);
+   }
+
+   std::vector<int> histogram = counts.get();
+   int zeros = counts.get(0);
+
+ * \endverbatim
+ *
+ ******************************************************************************
+ */
+template <typename REDUCE_POLICY_T, typename T>
+class ReduceArray;
 }  // closing brace for RAJA namespace
 
 #endif  // closing endif for header file include guard
@@ -41,7 +41,8 @@ enum class Policy {
   openmp,
   target_openmp,
   cuda,
-  tbb
+  tbb,
+  lws
 };
 
 enum class Pattern { undefined, forall, region, reduce, taskgraph, synchronize };
@@ -114,6 +115,9 @@ namespace reduce
 struct ordered {
 };
 
+struct reproducible {
+};
+
 }  // end namespace wrapper
 
 
@@ -169,6 +173,9 @@ template <typename Pol>
 struct is_tbb_policy : RAJA::policy_is<Pol, RAJA::Policy::tbb> {
 };
 template <typename Pol>
+struct is_lws_policy : RAJA::policy_is<Pol, RAJA::Policy::lws> {
+};
+template <typename Pol>
 struct is_target_openmp_policy
     : RAJA::policy_is<Pol, RAJA::Policy::target_openmp> {
 };
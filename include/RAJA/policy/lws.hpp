@@ -0,0 +1,46 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file containing RAJA headers for the lws std::thread
+ *          execution.
+ *
+ *          These methods work only on platforms that support std::thread.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_HPP
+#define RAJA_lws_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_LWS_THREADS)
+
+#include "RAJA/policy/lws/forall.hpp"
+#include "RAJA/policy/lws/policy.hpp"
+#include "RAJA/policy/lws/reduce.hpp"
+#include "RAJA/policy/lws/scan.hpp"
+#include "RAJA/policy/lws/thread_pool.hpp"
+#include "RAJA/policy/openmp/lws_stats.hpp"
+#include "RAJA/policy/openmp/lws_trace.hpp"
+
+#endif
+
+#endif  // closing endif for header file include guard
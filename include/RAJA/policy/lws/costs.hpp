@@ -0,0 +1,71 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file containing the iteration costs that the weighted lws
+ *          policies partition a loop by.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_costs_HPP
+#define RAJA_lws_costs_HPP
+
+namespace RAJA
+{
+namespace lws
+{
+
+/*!
+ * \brief The non-negative costs of the iterations of a loop, by position in
+ *        the segment the loop runs over (not by index value).
+ *
+ *        Either data[k] is the cost of iteration k, or data is a prefix sum
+ *        of n + 1 entries where data[k + 1] - data[k] is the cost of
+ *        iteration k, like the row offsets of a CSR matrix.
+ */
+template <typename T>
+struct cost_view {
+  const T* data;
+  bool is_prefix;
+};
+
+/*!
+ * \brief Costs given per iteration; the weighted policies build the prefix
+ *        sum in parallel before the loop.
+ */
+template <typename T>
+cost_view<T> iteration_costs(const T* cost)
+{
+  return cost_view<T>{cost, false};
+}
+
+/*!
+ * \brief Costs given as a prefix sum of n + 1 entries.
+ */
+template <typename T>
+cost_view<T> cost_prefix(const T* prefix)
+{
+  return cost_view<T>{prefix, true};
+}
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for header file include guard
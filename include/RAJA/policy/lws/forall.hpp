@@ -4,11 +4,9 @@
  * \file
  *
  * \brief   Header file containing RAJA index set and segment iteration
- *          template methods for sequential execution.
+ *          template methods for the lws std::thread policies.
  *
- *          These methods should work on any platform.
- *
- *          Note: GNU compiler does not enforce sequential iterations.
+ *          These methods run on the lws thread pool and need no OpenMP.
  *
  ******************************************************************************
  */
@@ -28,52 +26,168 @@
 //
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 
-#ifndef RAJA_forall_sequential_HPP
-#define RAJA_forall_sequential_HPP
+#ifndef RAJA_forall_lws_HPP
+#define RAJA_forall_lws_HPP
 
 #include "RAJA/config.hpp"
 
-#include "RAJA/util/types.hpp"
+#if defined(RAJA_ENABLE_LWS_THREADS)
 
-#include "RAJA/policy/sequential/policy.hpp"
+#include <vector>
+
+#include "RAJA/util/types.hpp"
 
 #include "RAJA/internal/fault_tolerance.hpp"
 
 #include "RAJA/pattern/detail/forall.hpp"
+#include "RAJA/pattern/forall.hpp"
+
+#include "RAJA/policy/lws/policy.hpp"
+#include "RAJA/policy/lws/schedule.hpp"
+#include "RAJA/policy/lws/thread_pool.hpp"
+#include "RAJA/policy/lws/weighted.hpp"
 
 namespace RAJA
 {
 namespace policy
 {
-namespace sequential
+namespace lws_threads
 {
 
+namespace detail
+{
 
-//
-//////////////////////////////////////////////////////////////////////
-//
-// The following function templates iterate over index set segments
-// sequentially.  Segment execution is defined by segment
-// execution policy template parameter.
-//
-//////////////////////////////////////////////////////////////////////
-//
+///
+/// lws loop on the thread pool. Every thread of the pool runs its static
+/// part and then steals; a loop started from a loop body runs on its thread
+/// alone, with its own scheduler context.
+///
+template <typename Strategy,
+          int StaticFractionPercent,
+          int ChunkSize,
+          typename Iterable,
+          typename Func>
+RAJA_INLINE void lws_forall(Iterable&& iter, Func&& loop_body)
+{
+  using RAJA::lws::detail::LwsStrategy;
+  using RAJA::lws::detail::lws_acquire;
+  using RAJA::lws::detail::lws_for_thread;
+
+  auto& pool = RAJA::lws::detail::thread_pool::instance();
+  vSched_context* ctx =
+      lws_acquire<Strategy, StaticFractionPercent, ChunkSize>(pool.size());
+
+  if (LwsStrategy<Strategy>::needs_context && ctx == nullptr) {
+    RAJA_EXTRACT_BED_IT(iter);
+    for (decltype(distance_it) i = 0; i < distance_it; ++i) {
+      loop_body(begin_it[i]);
+    }
+    return;
+  }
+
+  const RAJA::lws::detail::trace_loop loop =
+      RAJA::lws::detail::trace_new_loop();
+  pool.run([&](int threadNum, int numThreads) {
+    using RAJA::internal::thread_privatize;
+    auto body = thread_privatize(loop_body);
+    RAJA::lws::detail::trace_next_loop(loop);
+    lws_for_thread<Strategy>(ctx, iter, body.get_priv(), threadNum, numThreads);
+  });
+
+  if (ctx != nullptr) {
+    vSched_context_release(ctx);
+  }
+}
+
+}  // closing brace for detail namespace
 
 template <typename Iterable, typename Func>
-RAJA_INLINE void forall_impl(const seq_exec &, Iterable &&iter, Func &&body)
+RAJA_INLINE void forall_impl(const lws_exec&, Iterable&& iter, Func&& loop_body)
+{
+  detail::lws_forall<RAJA::lws::statdynstaggered,
+                     RAJA::lws::detail::lws_runtime_fraction,
+                     0>(iter, loop_body);
+}
+
+template <typename Iterable,
+          typename Func,
+          typename Strategy,
+          int StaticFractionPercent,
+          int ChunkSize>
+RAJA_INLINE void forall_impl(
+    const lws_strategy_exec<Strategy, StaticFractionPercent, ChunkSize>&,
+    Iterable&& iter,
+    Func&& loop_body)
+{
+  detail::lws_forall<Strategy, StaticFractionPercent, ChunkSize>(iter,
+                                                                 loop_body);
+}
+
+///
+/// lws loop split by iteration cost. Costs given per iteration are summed
+/// into a prefix on the pool first, in one block per thread of the pool;
+/// the blocks stay the same if a run gets fewer threads.
+///
+template <typename Iterable, typename Func, typename T>
+RAJA_INLINE void forall_impl(const lws_weighted_exec<T>& p,
+                             Iterable&& iter,
+                             Func&& loop_body)
 {
+  using RAJA::lws::detail::weighted_block_prefix;
+  using RAJA::lws::detail::weighted_block_sum;
+
   RAJA_EXTRACT_BED_IT(iter);
+  const int n = static_cast<int>(distance_it);
+  auto& pool = RAJA::lws::detail::thread_pool::instance();
+  const int blocks = pool.size();
+  vSched_context* ctx = vSched_context_acquire(blocks);
+  if (ctx == nullptr) {
+    for (int i = 0; i < n; ++i) {
+      loop_body(begin_it[i]);
+    }
+    return;
+  }
 
-  RAJA_NO_SIMD
-  for (decltype(distance_it) i = 0; i < distance_it; ++i) {
-    body(*(begin_it + i));
+  std::vector<double> prefix(p.costs.is_prefix ? 0 : n + 1);
+  if (!p.costs.is_prefix) {
+    std::vector<double> sums(blocks);
+    pool.run([&](int threadNum, int numThreads) {
+      for (int b = threadNum; b < blocks; b += numThreads) {
+        sums[b] = weighted_block_sum(p.costs.data, n, b, blocks);
+      }
+    });
+    for (int b = 1; b < blocks; ++b) {
+      sums[b] += sums[b - 1];
+    }
+    pool.run([&](int threadNum, int numThreads) {
+      for (int b = threadNum; b < blocks; b += numThreads) {
+        weighted_block_prefix(p.costs.data,
+                              n,
+                              b,
+                              blocks,
+                              (b == 0) ? 0.0 : sums[b - 1],
+                              prefix.data());
+      }
+    });
   }
-}
 
-}  // closing brace for sequential namespace
+  const RAJA::lws::detail::cost_map<T> map(p.costs, prefix.data(), n);
+  const RAJA::lws::detail::trace_loop loop =
+      RAJA::lws::detail::trace_new_loop();
+  pool.run([&](int threadNum, int numThreads) {
+    using RAJA::internal::thread_privatize;
+    auto body = thread_privatize(loop_body);
+    RAJA::lws::detail::trace_next_loop(loop);
+    RAJA::lws::detail::lws_for_thread_weighted<RAJA::lws::statdynstaggered>(
+        ctx, iter, map, body.get_priv(), threadNum, numThreads);
+  });
+  vSched_context_release(ctx);
+}
 
+}  // closing brace for lws_threads namespace
 }  // closing brace for policy namespace
-
 }  // closing brace for RAJA namespace
 
+#endif  // closing endif for if defined(RAJA_ENABLE_LWS_THREADS)
+
 #endif  // closing endif for header file include guard
@@ -3,7 +3,7 @@
  *
  * \file
  *
- * \brief   Header file containing RAJA sequential policy definitions.
+ * \brief   Header file containing RAJA lws std::thread policy definitions.
  *
  ******************************************************************************
  */
@@ -23,16 +23,18 @@
 //
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 
-#ifndef policy_sequential_HPP
-#define policy_sequential_HPP
+#ifndef policy_lws_HPP
+#define policy_lws_HPP
 
 #include "RAJA/policy/PolicyBase.hpp"
+#include "RAJA/policy/lws/costs.hpp"
+#include "RAJA/policy/lws/strategy.hpp"
 
 namespace RAJA
 {
 namespace policy
 {
-namespace sequential
+namespace lws_threads
 {
 
 //
@@ -44,25 +46,60 @@ namespace sequential
 //
 
 ///
-/// Segment execution policies
+/// Segment execution policies. The loops run on the persistent thread pool
+/// of the lws backend (see thread_pool.hpp), scheduled by vSched like the
+/// OpenMP lws policies, without needing OpenMP.
 ///
 
-struct seq_region : make_policy_pattern_launch_platform_t<Policy::sequential,
-                                                          Pattern::region,
-                                                          Launch::sync,
-                                                          Platform::host> {
-};
-
-struct seq_exec : make_policy_pattern_launch_platform_t<Policy::sequential,
+///
+/// statdynstaggered scheduling with the static fraction and chunk size of
+/// setStaticFraction(), like omp_lws.
+///
+struct lws_exec : make_policy_pattern_launch_platform_t<Policy::lws,
                                                         Pattern::forall,
                                                         Launch::undefined,
                                                         Platform::host> {
 };
 
+///
+/// lws scheduling with the strategy, static fraction (in percent of the
+/// iterations) and chunk size fixed at compile time, like
+/// omp_parallel_for_lws.
+///
+template <typename Strategy = RAJA::lws::statdynstaggered,
+          int StaticFractionPercent = 50,
+          int ChunkSize = 16>
+struct lws_strategy_exec
+    : make_policy_pattern_launch_platform_t<Policy::lws,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host> {
+  static_assert(StaticFractionPercent >= 0 && StaticFractionPercent <= 100,
+                "lws static fraction must be a percentage");
+  static_assert(ChunkSize > 0, "lws chunk size must be positive");
+};
+
+///
+/// lws scheduling that splits the loop by the cost of its iterations, like
+/// omp_lws_weighted.
+///
+template <typename T>
+struct lws_weighted_exec
+    : make_policy_pattern_launch_platform_t<Policy::lws,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host> {
+  explicit lws_weighted_exec(RAJA::lws::cost_view<T> costs_) : costs(costs_)
+  {
+  }
+
+  RAJA::lws::cost_view<T> costs;
+};
+
 ///
 /// Index set segment iteration policies
 ///
-using seq_segit = seq_exec;
+using lws_segit = lws_exec;
 
 ///
 ///////////////////////////////////////////////////////////////////////
@@ -71,30 +108,20 @@ using seq_segit = seq_exec;
 ///
 ///////////////////////////////////////////////////////////////////////
 ///
-struct seq_reduce : make_policy_pattern_launch_platform_t<Policy::sequential,
-                                                          Pattern::forall,
+struct lws_reduce : make_policy_pattern_launch_platform_t<Policy::lws,
+                                                          Pattern::reduce,
                                                           Launch::undefined,
                                                           Platform::host> {
 };
-}  // end namespace policy
-}  // end namespace sequential
-
-using policy::sequential::seq_exec;
-using policy::sequential::seq_region;
-using policy::sequential::seq_segit;
-using policy::sequential::seq_reduce;
 
+}  // closing brace for lws_threads namespace
+}  // closing brace for policy namespace
 
-///
-///////////////////////////////////////////////////////////////////////
-///
-/// Shared memory policies
-///
-///////////////////////////////////////////////////////////////////////
-///
-
-struct seq_shmem {
-};
+using policy::lws_threads::lws_exec;
+using policy::lws_threads::lws_strategy_exec;
+using policy::lws_threads::lws_weighted_exec;
+using policy::lws_threads::lws_segit;
+using policy::lws_threads::lws_reduce;
 
 }  // closing brace for RAJA namespace
 
@@ -3,10 +3,8 @@
  *
  * \file
  *
- * \brief   Header file containing RAJA reduction templates for
- *          sequential execution.
- *
- *          These methods should work on any platform.
+ * \brief   Header file containing RAJA reduction templates for the lws
+ *          std::thread policies.
  *
  ******************************************************************************
  */
@@ -26,43 +24,91 @@
 //
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 
-#ifndef RAJA_sequential_reduce_HPP
-#define RAJA_sequential_reduce_HPP
+#ifndef RAJA_lws_reduce_HPP
+#define RAJA_lws_reduce_HPP
 
 #include "RAJA/config.hpp"
 
-#include "RAJA/internal/MemUtils_CPU.hpp"
+#if defined(RAJA_ENABLE_LWS_THREADS)
+
+#include <memory>
+
+#include "RAJA/util/types.hpp"
 
 #include "RAJA/pattern/detail/reduce.hpp"
+#include "RAJA/pattern/detail/reduce_array.hpp"
+#include "RAJA/pattern/detail/reduce_slots.hpp"
 #include "RAJA/pattern/reduce.hpp"
 
-#include "RAJA/policy/sequential/policy.hpp"
-
-#include "RAJA/util/types.hpp"
+#include "RAJA/policy/lws/policy.hpp"
+#include "RAJA/policy/lws/thread_pool.hpp"
 
 namespace RAJA
 {
 
 namespace detail
 {
+
+///
+/// Combines the copies of a reducer made by the threads of the lws pool
+/// into per-thread slots, indexed by pool thread number, the way ReduceOMP
+/// does for OpenMP threads.
+///
 template <typename T, typename Reduce>
-class ReduceSeq
-    : public reduce::detail::BaseCombinable<T, Reduce, ReduceSeq<T, Reduce>>
+class ReduceLws
+    : public reduce::detail::BaseCombinable<T, Reduce, ReduceLws<T, Reduce>>
 {
-  using Base = reduce::detail::BaseCombinable<T, Reduce, ReduceSeq<T, Reduce>>;
+  using Base = reduce::detail::BaseCombinable<T, Reduce, ReduceLws>;
+  // only the reducer the copies are made from has slots, one per thread
+  std::unique_ptr<reduce::detail::ReduceSlots<T>> slots;
 
 public:
   //! prohibit compiler-generated default ctor
-  ReduceSeq() = delete;
-
-  using Base::Base;
+  ReduceLws() = delete;
+
+  ReduceLws(T init_val, T identity_ = T())
+      : Base(init_val, identity_),
+        slots(new reduce::detail::ReduceSlots<T>(
+            lws::detail::thread_pool::instance().size(), identity_))
+  {
+  }
+
+  ReduceLws(const ReduceLws& other) : Base(other) {}
+
+  void reset(T init_val, T identity_)
+  {
+    Base::reset(init_val, identity_);
+    if (slots) {
+      slots->reset(identity_);
+    }
+  }
+
+  ~ReduceLws()
+  {
+    if (Base::parent) {
+      static_cast<const ReduceLws*>(Base::parent)
+          ->slots->template combine<Reduce>(
+              lws::detail::thread_pool::thread_num(), Base::my_data);
+      Base::my_data = Base::identity;
+    }
+  }
+
+  T get_combined() const
+  {
+    if (slots) {
+      slots->template collect<Reduce>(Base::my_data, Base::identity);
+    }
+    return Base::my_data;
+  }
 };
 
-
 } /* detail */
 
-RAJA_DECLARE_ALL_REDUCERS(seq_reduce, detail::ReduceSeq)
+RAJA_DECLARE_ALL_REDUCERS(lws_reduce, detail::ReduceLws)
+RAJA_DECLARE_ARRAY_REDUCER(lws_reduce, reduce::detail::ReduceArrayPrivate)
 
 }  // closing brace for RAJA namespace
 
+#endif  // closing endif for RAJA_ENABLE_LWS_THREADS guard
+
 #endif  // closing endif for header file include guard
@@ -3,7 +3,8 @@
 *
 * \file
 *
-* \brief   Header file providing RAJA scan declarations.
+* \brief   Header file providing RAJA scan declarations for the lws
+*          std::thread policies.
 *
 ******************************************************************************
 */
@@ -23,20 +24,23 @@
 //
 //~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
 
-#ifndef RAJA_scan_sequential_HPP
-#define RAJA_scan_sequential_HPP
+#ifndef RAJA_scan_lws_HPP
+#define RAJA_scan_lws_HPP
 
 #include "RAJA/config.hpp"
 
+#if defined(RAJA_ENABLE_LWS_THREADS)
+
 #include <algorithm>
-#include <functional>
 #include <iterator>
-
-#include "RAJA/util/macros.hpp"
+#include <type_traits>
+#include <vector>
 
 #include "RAJA/util/concepts.hpp"
 
-#include "RAJA/policy/sequential/policy.hpp"
+#include "RAJA/policy/lws/policy.hpp"
+#include "RAJA/policy/lws/thread_pool.hpp"
+#include "RAJA/policy/sequential/scan.hpp"
 
 namespace RAJA
 {
@@ -44,90 +48,142 @@ namespace impl
 {
 namespace scan
 {
+
+namespace detail
+{
+
+RAJA_INLINE
+int lws_block_begin(int n, int blocks, int block)
+{
+  return (static_cast<size_t>(n) * block) / blocks;
+}
+
+///
+/// Scans [begin, end) in blocks on the lws thread pool: every block is
+/// reduced, the block sums are scanned into the value each block starts
+/// from, and every block is scanned from it. BlockScan(first, last, init)
+/// scans one block.
+///
+template <typename Iter, typename BinFn, typename Value, typename BlockScan>
+void lws_scan_blocks(Iter begin,
+                     Iter end,
+                     BinFn f,
+                     Value init,
+                     BlockScan block_scan)
+{
+  const int n = end - begin;
+  if (n <= 0) {
+    return;
+  }
+  auto& pool = RAJA::lws::detail::thread_pool::instance();
+  const int blocks = std::min(n, pool.size());
+  ::std::vector<Value> sums(blocks, Value());
+
+  pool.run([&](int threadNum, int numThreads) {
+    for (int b = threadNum; b < blocks; b += numThreads) {
+      const int i0 = lws_block_begin(n, blocks, b);
+      const int i1 = lws_block_begin(n, blocks, b + 1);
+      Value agg = *(begin + i0);
+      for (int i = i0 + 1; i < i1; ++i) {
+        agg = f(agg, *(begin + i));
+      }
+      sums[b] = agg;
+    }
+  });
+
+  exclusive_inplace(
+      ::RAJA::seq_exec{}, sums.data(), sums.data() + blocks, f, init);
+
+  pool.run([&](int threadNum, int numThreads) {
+    for (int b = threadNum; b < blocks; b += numThreads) {
+      block_scan(begin + lws_block_begin(n, blocks, b),
+                 begin + lws_block_begin(n, blocks, b + 1),
+                 sums[b]);
+    }
+  });
+}
+
+}  // namespace detail
+
 /*!
         \brief explicit inclusive inplace scan given range, function, and
    initial value
 */
-template <typename ExecPolicy, typename Iter, typename BinFn>
-concepts::enable_if<type_traits::is_sequential_policy<ExecPolicy>>
-inclusive_inplace(const ExecPolicy &, Iter begin, Iter end, BinFn f)
+template <typename Policy, typename Iter, typename BinFn>
+concepts::enable_if<type_traits::is_lws_policy<Policy>> inclusive_inplace(
+    const Policy&,
+    Iter begin,
+    Iter end,
+    BinFn f)
 {
-  auto agg = *begin;
-
-  RAJA_NO_SIMD
-  for (Iter i = ++begin; i != end; ++i) {
-    agg = f(*i, agg);
-    *i = agg;
-  }
+  using Value = typename ::std::iterator_traits<Iter>::value_type;
+  detail::lws_scan_blocks(
+      begin, end, f, Value(BinFn::identity()), [=](Iter i0, Iter i1, Value v) {
+        for (Iter i = i0; i != i1; ++i) {
+          v = f(v, *i);
+          *i = v;
+        }
+      });
 }
 
 /*!
         \brief explicit exclusive inplace scan given range, function, and
    initial value
 */
-template <typename ExecPolicy, typename Iter, typename BinFn, typename T>
-concepts::enable_if<type_traits::is_sequential_policy<ExecPolicy>>
-exclusive_inplace(const ExecPolicy &, Iter begin, Iter end, BinFn f, T v)
+template <typename Policy, typename Iter, typename BinFn, typename ValueT>
+concepts::enable_if<type_traits::is_lws_policy<Policy>> exclusive_inplace(
+    const Policy&,
+    Iter begin,
+    Iter end,
+    BinFn f,
+    ValueT v)
 {
-  const int n = end - begin;
-  decltype(*begin) agg = v;
-
-  RAJA_NO_SIMD
-  for (int i = 0; i < n; ++i) {
-    auto t = *(begin + i);
-    *(begin + i) = agg;
-    agg = f(agg, t);
-  }
+  using Value = typename ::std::iterator_traits<Iter>::value_type;
+  detail::lws_scan_blocks(
+      begin, end, f, Value(v), [=](Iter i0, Iter i1, Value agg) {
+        for (Iter i = i0; i != i1; ++i) {
+          Value t = *i;
+          *i = agg;
+          agg = f(agg, t);
+        }
+      });
 }
 
 /*!
         \brief explicit inclusive scan given input range, output, function, and
    initial value
 */
-template <typename ExecPolicy, typename Iter, typename OutIter, typename BinFn>
-concepts::enable_if<type_traits::is_sequential_policy<ExecPolicy>> inclusive(
-    const ExecPolicy &,
-    const Iter begin,
-    const Iter end,
+template <typename Policy, typename Iter, typename OutIter, typename BinFn>
+concepts::enable_if<type_traits::is_lws_policy<Policy>> inclusive(
+    const Policy& exec,
+    Iter begin,
+    Iter end,
     OutIter out,
     BinFn f)
 {
-  auto agg = *begin;
-  *out++ = agg;
-
-  RAJA_NO_SIMD
-  for (Iter i = begin + 1; i != end; ++i) {
-    agg = f(agg, *i);
-    *out++ = agg;
-  }
+  ::std::copy(begin, end, out);
+  inclusive_inplace(exec, out, out + (end - begin), f);
 }
 
 /*!
         \brief explicit exclusive scan given input range, output, function, and
    initial value
 */
-template <typename ExecPolicy,
+template <typename Policy,
           typename Iter,
           typename OutIter,
           typename BinFn,
-          typename T>
-concepts::enable_if<type_traits::is_sequential_policy<ExecPolicy>> exclusive(
-    const ExecPolicy &,
-    const Iter begin,
-    const Iter end,
+          typename ValueT>
+concepts::enable_if<type_traits::is_lws_policy<Policy>> exclusive(
+    const Policy& exec,
+    Iter begin,
+    Iter end,
     OutIter out,
     BinFn f,
-    T v)
+    ValueT v)
 {
-  decltype(*begin) agg = v;
-  OutIter o = out;
-  *o++ = v;
-
-  RAJA_NO_SIMD
-  for (Iter i = begin; i != end - 1; ++i, ++o) {
-    agg = f(*i, agg);
-    *o = agg;
-  }
+  ::std::copy(begin, end, out);
+  exclusive_inplace(exec, out, out + (end - begin), f, v);
 }
 
 }  // namespace scan
@@ -136,4 +192,6 @@ concepts::enable_if<type_traits::is_sequential_policy<ExecPolicy>> exclusive(
 
 }  // namespace RAJA
 
+#endif  // closing endif for if defined(RAJA_ENABLE_LWS_THREADS)
+
 #endif
@@ -0,0 +1,230 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file containing the lws chunk loop that the OpenMP and the
+ *          std::thread lws policies share.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_schedule_HPP
+#define RAJA_lws_schedule_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP) || defined(RAJA_ENABLE_LWS_THREADS)
+
+#include <iterator>
+
+#include "RAJA/util/macros.hpp"
+
+#include "RAJA/pattern/detail/forall.hpp"
+
+#include "RAJA/policy/lws/strategy.hpp"
+#include "RAJA/policy/openmp/lws_stats.hpp"
+#include "RAJA/policy/openmp/lws_trace.hpp"
+#include "RAJA/policy/openmp/vSched_internal.h"
+
+namespace RAJA
+{
+namespace lws
+{
+namespace detail
+{
+
+///
+/// Maps an lws strategy to its vSched loop_start/loop_next pair. The
+/// strategy is resolved at compile time, so the chunk loop makes direct
+/// calls, and the common case of statdynstaggered (claiming a chunk from the
+/// thread's own queue) is inlined.
+///
+template <typename Strategy>
+struct LwsStrategy;
+
+template <>
+struct LwsStrategy<lws::static_schedule> {
+  static constexpr bool needs_context = false;
+
+  RAJA_INLINE static void start(vSched_context*,
+                                int begin,
+                                int end,
+                                int* pstart,
+                                int* pend,
+                                int tid,
+                                int numThreads)
+  {
+    loop_start_static(begin, end, pstart, pend, tid, numThreads);
+  }
+
+  RAJA_INLINE static bool next(vSched_context*, int*, int*, int)
+  {
+    return false;
+  }
+};
+
+///
+/// A strategy that is a plain loop_start/loop_next pair of vSched.
+///
+template <int (*Start)(vSched_context*, int, int, int*, int*, int, int),
+          int (*Next)(vSched_context*, int*, int*, int)>
+struct LwsStartNext {
+  static constexpr bool needs_context = true;
+
+  RAJA_INLINE static void start(vSched_context* ctx,
+                                int begin,
+                                int end,
+                                int* pstart,
+                                int* pend,
+                                int tid,
+                                int numThreads)
+  {
+    Start(ctx, begin, end, pstart, pend, tid, numThreads);
+  }
+
+  RAJA_INLINE static bool next(vSched_context* ctx,
+                               int* pstart,
+                               int* pend,
+                               int tid)
+  {
+    return Next(ctx, pstart, pend, tid);
+  }
+};
+
+template <>
+struct LwsStrategy<lws::static_fraction>
+    : LwsStartNext<loop_start_static_fraction_ctx,
+                   loop_next_static_fraction_ctx> {
+};
+
+template <>
+struct LwsStrategy<lws::cdy>
+    : LwsStartNext<loop_start_cdy_ctx, loop_next_cdy_ctx> {
+};
+
+template <>
+struct LwsStrategy<lws::guided>
+    : LwsStartNext<loop_start_guided_ctx, loop_next_guided_ctx> {
+};
+
+template <>
+struct LwsStrategy<lws::factoring>
+    : LwsStartNext<loop_start_factoring_ctx, loop_next_factoring_ctx> {
+};
+
+template <>
+struct LwsStrategy<lws::trapezoid>
+    : LwsStartNext<loop_start_trapezoid_ctx, loop_next_trapezoid_ctx> {
+};
+
+template <>
+struct LwsStrategy<lws::statdynstaggered> {
+  static constexpr bool needs_context = true;
+
+  RAJA_INLINE static void start(vSched_context* ctx,
+                                int begin,
+                                int end,
+                                int* pstart,
+                                int* pend,
+                                int tid,
+                                int numThreads)
+  {
+    loop_start_statdynstaggered_ctx(
+        ctx, begin, end, pstart, pend, tid, numThreads);
+  }
+
+  RAJA_INLINE static bool next(vSched_context* ctx,
+                               int* pstart,
+                               int* pend,
+                               int tid)
+  {
+#if defined(RAJA_ENABLE_LWS_STATS)
+    // every dequeue goes through vSched so that it is recorded
+    return loop_next_statdynstaggered_ctx(ctx, pstart, pend, tid);
+#else
+    return vSched_claim_own(ctx, pstart, pend, tid)
+           || loop_next_statdynstaggered_ctx(ctx, pstart, pend, tid);
+#endif
+  }
+};
+
+///
+/// StaticFractionPercent of the lws policies that take their static fraction
+/// and chunk size from setStaticFraction() at run time.
+///
+constexpr int lws_runtime_fraction = -1;
+
+template <typename Strategy, int StaticFractionPercent, int ChunkSize>
+RAJA_INLINE vSched_context* lws_acquire(int numThreads)
+{
+  if (!LwsStrategy<Strategy>::needs_context) {
+    return nullptr;
+  }
+  vSched_context* ctx = vSched_context_acquire(numThreads);
+  if (ctx != nullptr && StaticFractionPercent != lws_runtime_fraction) {
+    vSched_context_set_static_fraction(ctx,
+                                       StaticFractionPercent / 100.0f,
+                                       ChunkSize);
+  }
+  return ctx;
+}
+
+
+///
+/// Runs thread threadNum's part of an lws loop scheduled by ctx: the static
+/// part of its share, then the chunks the strategy hands out.
+///
+template <typename Strategy, typename Iterable, typename Func>
+RAJA_INLINE void lws_for_thread(vSched_context* ctx,
+                                Iterable&& iter,
+                                Func&& loop_body,
+                                int threadNum,
+                                int numThreads)
+{
+  using strategy = LwsStrategy<Strategy>;
+  RAJA_EXTRACT_BED_IT(iter);
+  int startInd, endInd;
+
+  strategy::start(ctx,
+                  0,
+                  static_cast<int>(distance_it),
+                  &startInd,
+                  &endInd,
+                  threadNum,
+                  numThreads);
+  body_timer timer;
+  chunk_tracer trace(threadNum);
+  do {
+    trace.start(startInd, endInd);
+    timer.start();
+    for (decltype(distance_it) i = startInd; i < endInd; ++i) {
+      loop_body(begin_it[i]);
+    }
+    timer.stop();
+    trace.stop();
+  } while (strategy::next(ctx, &startInd, &endInd, threadNum));
+}
+
+}  // closing brace for detail namespace
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for RAJA_ENABLE_OPENMP or RAJA_ENABLE_LWS_THREADS
+
+#endif  // closing endif for header file include guard
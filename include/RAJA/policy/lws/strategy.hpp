@@ -0,0 +1,76 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file containing the scheduling strategies of the lws
+ *          policies.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_strategy_HPP
+#define RAJA_lws_strategy_HPP
+
+namespace RAJA
+{
+
+///
+/// Scheduling strategies for the lws policies, see vSched.c.
+///
+namespace lws
+{
+
+/// one contiguous block per thread, no dequeues
+struct static_schedule {
+};
+
+/// a static block per thread, the rest in chunks from one shared counter
+struct static_fraction {
+};
+
+/// a static block per thread, the rest in chunks handed out while a
+/// constraint holds (see setCDY and setCDYConstraint)
+struct cdy {
+};
+
+/// a static block per thread, the rest in chunks from per-thread queues
+/// that idle threads steal from
+struct statdynstaggered {
+};
+
+/// a static block per thread, the rest in chunks of the remaining work
+/// divided by the number of threads (guided self-scheduling)
+struct guided {
+};
+
+/// a static block per thread, the rest in batches of one chunk per thread
+/// that each cover half of the remaining work (factoring)
+struct factoring {
+};
+
+/// a static block per thread, the rest in chunks whose size decreases
+/// linearly down to the chunk size (trapezoid self-scheduling)
+struct trapezoid {
+};
+
+}  // closing brace for lws namespace
+
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for header file include guard
@@ -0,0 +1,135 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file for the persistent thread pool that runs the loops
+ *          of the lws std::thread policies.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_thread_pool_HPP
+#define RAJA_lws_thread_pool_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_LWS_THREADS)
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "RAJA/policy/openmp/vSched_internal.h"
+
+namespace RAJA
+{
+namespace lws
+{
+namespace detail
+{
+
+/*!
+ * \brief Persistent pool of worker threads for the lws_exec policies.
+ *
+ *        The pool has RAJA_LWS_NUM_THREADS threads, counting the thread
+ *        that runs a job, or one per CPU the process may run on. Workers
+ *        are pinned to those CPUs, one each, unless there are more threads
+ *        than CPUs. Between jobs they spin briefly and then sleep on a
+ *        futex (Linux) or yield (elsewhere).
+ *
+ *        A job runs on every thread of the pool at once. A job started
+ *        while another one runs, from a loop body or from another thread,
+ *        runs on the calling thread alone.
+ */
+class thread_pool
+{
+public:
+  static thread_pool& instance();
+
+  thread_pool(const thread_pool&) = delete;
+  thread_pool& operator=(const thread_pool&) = delete;
+
+  ~thread_pool();
+
+  //! number of threads that run a job, including the caller
+  int size() const { return static_cast<int>(m_workers.size()) + 1; }
+
+  //! the pool thread number of the calling thread; 0 outside the workers
+  static int thread_num();
+
+  /*!
+   * \brief Calls job(threadNum, numThreads) on numThreads threads and
+   *        returns when all calls have returned. The calling thread is
+   *        thread 0.
+   */
+  template <typename Job>
+  void run(Job&& job)
+  {
+    using job_type = typename std::remove_reference<Job>::type;
+    run_job(&invoke<job_type>, &job);
+  }
+
+private:
+  using job_fn = void (*)(void*, int, int);
+
+  struct alignas(VSCHED_CACHE_LINE) padded_counter {
+    std::atomic<int> value{0};
+  };
+
+  thread_pool();
+
+  template <typename Job>
+  static void invoke(void* job, int threadNum, int numThreads)
+  {
+    (*static_cast<Job*>(job))(threadNum, numThreads);
+  }
+
+  void run_job(job_fn fn, void* job);
+
+  void worker(int threadNum, int cpu);
+
+  std::vector<std::thread> m_workers;
+
+  job_fn m_fn = nullptr;
+  void* m_job = nullptr;
+  std::atomic<bool> m_busy{false};
+  std::atomic<bool> m_stop{false};
+
+  // bumped to start a job; workers sleep on it
+  padded_counter m_generation;
+  // workers sleeping on m_generation
+  padded_counter m_sleepers;
+  // workers that have not finished the current job
+  padded_counter m_remaining;
+};
+
+}  // closing brace for detail namespace
+
+/*!
+ * \brief Returns the number of threads that run lws_exec loops.
+ */
+inline int get_num_threads() { return detail::thread_pool::instance().size(); }
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for if defined(RAJA_ENABLE_LWS_THREADS)
+
+#endif  // closing endif for header file include guard
@@ -0,0 +1,209 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file containing the cost-weighted lws chunk loop that the
+ *          OpenMP and the std::thread weighted lws policies share.
+ *
+ *          A weighted loop of n iterations is scheduled over n units of
+ *          equal cost instead of over its iterations: the static part of
+ *          every thread and every dynamic chunk cover the same cost, and a
+ *          range of units is mapped to the iterations whose costs start in
+ *          it with a binary search of the prefix sum of the costs.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_weighted_HPP
+#define RAJA_lws_weighted_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP) || defined(RAJA_ENABLE_LWS_THREADS)
+
+#include <algorithm>
+#include <cstddef>
+
+#include "RAJA/util/macros.hpp"
+
+#include "RAJA/policy/lws/costs.hpp"
+#include "RAJA/policy/lws/schedule.hpp"
+
+namespace RAJA
+{
+namespace lws
+{
+namespace detail
+{
+
+RAJA_INLINE
+int weighted_block_begin(int n, int blocks, int block)
+{
+  return static_cast<int>((static_cast<size_t>(n) * block) / blocks);
+}
+
+///
+/// Sum of the costs of block of the iterations split into blocks.
+///
+template <typename T>
+RAJA_INLINE double weighted_block_sum(const T* cost,
+                                      int n,
+                                      int block,
+                                      int blocks)
+{
+  const int i1 = weighted_block_begin(n, blocks, block + 1);
+  double sum = 0.0;
+  for (int i = weighted_block_begin(n, blocks, block); i < i1; ++i) {
+    sum += static_cast<double>(cost[i]);
+  }
+  return sum;
+}
+
+///
+/// Writes the prefix sum of the costs of block, given the sum of the costs
+/// of the blocks before it, to prefix (of n + 1 entries).
+///
+template <typename T>
+RAJA_INLINE void weighted_block_prefix(const T* cost,
+                                       int n,
+                                       int block,
+                                       int blocks,
+                                       double offset,
+                                       double* prefix)
+{
+  if (block == 0) {
+    prefix[0] = 0.0;
+  }
+  const int i1 = weighted_block_begin(n, blocks, block + 1);
+  for (int i = weighted_block_begin(n, blocks, block); i < i1; ++i) {
+    offset += static_cast<double>(cost[i]);
+    prefix[i + 1] = offset;
+  }
+}
+
+///
+/// Maps the cost units of a weighted loop of n iterations to its
+/// iterations. The prefix sum is either the cost view itself or the one
+/// built from its per-iteration costs.
+///
+template <typename T>
+class cost_map
+{
+public:
+  cost_map(cost_view<T> costs, const double* built, int n)
+      : m_view(costs.is_prefix ? costs.data : nullptr),
+        m_built(costs.is_prefix ? nullptr : built),
+        m_n(n)
+  {
+    if (n > 0) {
+      m_base = m_view ? static_cast<double>(m_view[0]) : 0.0;
+      m_total =
+          (m_view ? static_cast<double>(m_view[n]) : m_built[n]) - m_base;
+    }
+  }
+
+  int units() const { return m_n; }
+
+  ///
+  /// The first iteration whose cost starts at or after unit; the units
+  /// [a, b) cover the iterations [iteration(a), iteration(b)).
+  ///
+  int iteration(int unit) const
+  {
+    if (unit <= 0) {
+      return 0;
+    }
+    if (unit >= m_n) {
+      return m_n;
+    }
+    if (!(m_total > 0.0)) {
+      // nothing costs anything, split by count
+      return unit;
+    }
+    const double target = m_base + m_total * unit / m_n;
+    return m_view ? search(m_view, target) : search(m_built, target);
+  }
+
+private:
+  template <typename P>
+  int search(const P* prefix, double target) const
+  {
+    return static_cast<int>(
+        std::lower_bound(prefix,
+                         prefix + m_n + 1,
+                         target,
+                         [](const P& p, double t) {
+                           return static_cast<double>(p) < t;
+                         })
+        - prefix);
+  }
+
+  const T* m_view;
+  const double* m_built;
+  int m_n;
+  double m_base = 0.0;
+  double m_total = 0.0;
+};
+
+///
+/// Runs thread threadNum's part of a weighted lws loop scheduled by ctx
+/// over the cost units of map.
+///
+template <typename Strategy, typename Iterable, typename T, typename Func>
+RAJA_INLINE void lws_for_thread_weighted(vSched_context* ctx,
+                                         Iterable&& iter,
+                                         const cost_map<T>& map,
+                                         Func&& loop_body,
+                                         int threadNum,
+                                         int numThreads)
+{
+  using strategy = LwsStrategy<Strategy>;
+  RAJA_EXTRACT_BED_IT(iter);
+  int startUnit, endUnit;
+  // chunks claimed from the thread's own queue follow each other, so the
+  // last search usually gives the first iteration of the next chunk
+  int lastUnit = 0, lastIteration = 0;
+
+  strategy::start(
+      ctx, 0, map.units(), &startUnit, &endUnit, threadNum, numThreads);
+  body_timer timer;
+  chunk_tracer trace(threadNum);
+  do {
+    const int first =
+        (startUnit == lastUnit) ? lastIteration : map.iteration(startUnit);
+    const int last = map.iteration(endUnit);
+    lastUnit = endUnit;
+    lastIteration = last;
+    trace.start(first, last);
+    timer.start();
+    for (decltype(distance_it) i = first; i < last; ++i) {
+      loop_body(begin_it[i]);
+    }
+    timer.stop();
+    trace.stop();
+  } while (strategy::next(ctx, &startUnit, &endUnit, threadNum));
+}
+
+}  // closing brace for detail namespace
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for RAJA_ENABLE_OPENMP or RAJA_ENABLE_LWS_THREADS
+
+#endif  // closing endif for header file include guard
@@ -33,8 +33,12 @@
 
 #if defined(RAJA_ENABLE_OPENMP)
 
+#include <algorithm>
 #include <iostream>
+#include <limits>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <omp.h>
 
@@ -51,7 +55,14 @@
 #include "RAJA/pattern/forall.hpp"
 #include "RAJA/pattern/region.hpp"
 
-#include "vSched.h"
+#include "RAJA/policy/lws/schedule.hpp"
+#include "RAJA/policy/lws/weighted.hpp"
+#include "RAJA/policy/openmp/lws_stats.hpp"
+#include "RAJA/policy/openmp/lws_sticky.hpp"
+#include "RAJA/policy/openmp/lws_trace.hpp"
+#include "RAJA/policy/openmp/lws_team.hpp"
+#include "RAJA/policy/openmp/lws_tuning.hpp"
+#include "RAJA/policy/openmp/vSched_internal.h"
 
 namespace RAJA
 {
@@ -70,15 +81,39 @@ RAJA_INLINE void forall_impl(const omp_parallel_exec<InnerPolicy>&,
                              Iterable&& iter,
                              Func&& loop_body)
 {
+  const lws::detail::trace_loop loop = lws::detail::trace_new_loop();
 
   RAJA::region<RAJA::omp_parallel_region>([&](){
 
       using RAJA::internal::thread_privatize;
       auto body = thread_privatize(loop_body);
+      lws::detail::trace_next_loop(loop);
       forall_impl(InnerPolicy{}, iter, body.get_priv());
+      // in case the inner policy isn't traced
+      lws::detail::trace_take_loop();
     });
 }
 
+namespace detail
+{
+
+///
+/// The loop that a loop inside a parallel region is traced as: the one its
+/// omp_parallel_exec policy started, else the next step of the RAJA::region
+/// it runs in. Every thread of the team calls it for every loop, so they
+/// agree on the step without synchronizing.
+///
+RAJA_INLINE lws::detail::trace_loop trace_region_loop()
+{
+  lws::detail::trace_loop loop = lws::detail::trace_take_loop();
+  if (loop.id == 0) {
+    loop = lws::detail::trace_region_next_loop(omp_get_level());
+  }
+  return loop;
+}
+
+}  // closing brace for detail namespace
+
 ///
 /// OpenMP for nowait policy implementation
 ///
@@ -88,8 +123,11 @@ RAJA_INLINE void forall_impl(const omp_for_nowait_exec&,
                              Func&& loop_body)
 {
   RAJA_EXTRACT_BED_IT(iter);
+  lws::detail::iteration_tracer trace(detail::trace_region_loop(),
+                                      omp_get_thread_num());
 #pragma omp for nowait
   for (decltype(distance_it) i = 0; i < distance_it; ++i) {
+    trace.visit(i);
     loop_body(begin_it[i]);
   }
 }
@@ -104,53 +142,581 @@ RAJA_INLINE void forall_impl(const omp_for_exec&,
                              Func&& loop_body)
 {
   RAJA_EXTRACT_BED_IT(iter);
-#pragma omp for
+  lws::detail::iteration_tracer trace(detail::trace_region_loop(),
+                                      omp_get_thread_num());
+  // the barrier of the loop is not part of its last chunk
+#pragma omp for nowait
   for (decltype(distance_it) i = 0; i < distance_it; ++i) {
+    trace.visit(i);
     loop_body(begin_it[i]);
   }
+  trace.end();
+#pragma omp barrier
 }
 
-  
+
+namespace detail
+{
+
+using lws::detail::LwsStrategy;
+using lws::detail::lws_acquire;
+using lws::detail::lws_runtime_fraction;
+
 ///
-/// OpenMP parallel lws policy implementation 
-  /// TODO: I think that we do need a templated initialization function in the code and then fix library structure to have templated function. Work on this quickly 
-  // and then get a use case for this to see whether it's actually needed. 
-  //
+/// Runs the calling thread's part of an lws loop scheduled by ctx.
+///
+template <typename Strategy, typename Iterable, typename Func>
+RAJA_INLINE void lws_for(vSched_context* ctx, Iterable&& iter, Func&& loop_body)
+{
+  lws::detail::lws_for_thread<Strategy>(
+      ctx, iter, loop_body, omp_get_thread_num(), omp_get_num_threads());
+}
+
+///
+/// lws_for that also appends the iterations the thread ran to ranges,
+/// merging adjacent chunks.
+///
+template <typename Strategy, typename Iterable, typename Func>
+RAJA_INLINE void lws_for_recorded(vSched_context* ctx,
+                                  Iterable&& iter,
+                                  Func&& loop_body,
+                                  std::vector<std::pair<long, long>>& ranges)
+{
+  using strategy = LwsStrategy<Strategy>;
+  RAJA_EXTRACT_BED_IT(iter);
+  int startInd, endInd;
+  int threadNum = omp_get_thread_num();
+  int numThreads = omp_get_num_threads();
+
+  strategy::start(ctx,
+                  0,
+                  static_cast<int>(distance_it),
+                  &startInd,
+                  &endInd,
+                  threadNum,
+                  numThreads);
+  lws::detail::body_timer timer;
+  lws::detail::chunk_tracer trace(threadNum);
+  do {
+    trace.start(startInd, endInd);
+    timer.start();
+    for (decltype(distance_it) i = startInd; i < endInd; ++i) {
+      loop_body(begin_it[i]);
+    }
+    timer.stop();
+    trace.stop();
+    if (startInd < endInd) {
+      if (!ranges.empty() && ranges.back().second == startInd) {
+        ranges.back().second = endInd;
+      } else {
+        ranges.emplace_back(startInd, endInd);
+      }
+    }
+  } while (strategy::next(ctx, &startInd, &endInd, threadNum));
+}
+
+///
+/// Runs the iterations the calling thread recorded in ranges. Its largest
+/// range is scheduled like the thread's share of a statdynstaggered loop:
+/// the static fraction of it runs first, and the rest goes into the
+/// thread's queue, which other threads steal from once they run out of
+/// work. The other ranges run before the queue.
+///
+template <typename Iterable, typename Func>
+RAJA_INLINE void lws_for_replayed(
+    vSched_context* ctx,
+    Iterable&& iter,
+    Func&& loop_body,
+    const std::vector<std::pair<long, long>>& ranges)
+{
+  using strategy = LwsStrategy<lws::statdynstaggered>;
+  RAJA_EXTRACT_BED_IT(iter);
+  const int threadNum = omp_get_thread_num();
+  const auto largest = std::max_element(
+      ranges.begin(),
+      ranges.end(),
+      [](const std::pair<long, long>& a, const std::pair<long, long>& b) {
+        return a.second - a.first < b.second - b.first;
+      });
+  int startInd = 0, endInd = 0;
+  if (largest != ranges.end()) {
+    startInd = static_cast<int>(largest->first);
+    endInd = static_cast<int>(largest->second);
+  }
+  const bool scheduled = loop_start_statdynstaggered_range_ctx(
+      ctx, startInd, endInd, &startInd, &endInd, threadNum,
+      omp_get_num_threads());
+
+  lws::detail::body_timer timer;
+  lws::detail::chunk_tracer trace(threadNum);
+  for (auto range = ranges.begin(); range != ranges.end(); ++range) {
+    if (range == largest) {
+      continue;
+    }
+    trace.start(static_cast<int>(range->first),
+                static_cast<int>(range->second));
+    timer.start();
+    for (long i = range->first; i < range->second; ++i) {
+      loop_body(begin_it[i]);
+    }
+    timer.stop();
+    trace.stop();
+  }
+  do {
+    trace.start(startInd, endInd);
+    timer.start();
+    for (decltype(distance_it) i = startInd; i < endInd; ++i) {
+      loop_body(begin_it[i]);
+    }
+    timer.stop();
+    trace.stop();
+  } while (scheduled && strategy::next(ctx, &startInd, &endInd, threadNum));
+}
+
+///
+/// lws loop inside a parallel region. The team shares a scheduler context
+/// that is released after the loop.
+///
+template <typename Strategy,
+          int StaticFractionPercent,
+          int ChunkSize,
+          typename Iterable,
+          typename Func>
+RAJA_INLINE void lws_forall_in_region(Iterable&& iter, Func&& loop_body)
+{
+  lws::detail::trace_next_loop(trace_region_loop());
+  vSched_context* ctx = nullptr;
+  if (LwsStrategy<Strategy>::needs_context) {
+#pragma omp single copyprivate(ctx)
+    ctx = lws_acquire<Strategy, StaticFractionPercent, ChunkSize>(
+        omp_get_num_threads());
+
+    if (ctx == nullptr) {
+      forall_impl(omp_for_exec{}, iter, loop_body);
+      return;
+    }
+  }
+
+  lws_for<Strategy>(ctx, iter, loop_body);
+
+#pragma omp barrier
+  if (ctx != nullptr) {
+#pragma omp master
+    vSched_context_release(ctx);
+  }
+}
+
+///
+/// lws loop in its own parallel region. The scheduler context is acquired
+/// before the region, so the loop needs no extra barriers.
+///
+template <typename Strategy,
+          int StaticFractionPercent,
+          int ChunkSize,
+          typename Iterable,
+          typename Func>
+RAJA_INLINE void lws_forall_parallel(Iterable&& iter, Func&& loop_body)
+{
+  vSched_context* ctx =
+      lws_acquire<Strategy, StaticFractionPercent, ChunkSize>(
+          omp_get_max_threads());
+
+  if (LwsStrategy<Strategy>::needs_context && ctx == nullptr) {
+    forall_impl(omp_parallel_for_exec{}, iter, loop_body);
+    return;
+  }
+
+  const lws::detail::trace_loop loop = lws::detail::trace_new_loop();
+  RAJA::region<RAJA::omp_parallel_region>([&]() {
+    using RAJA::internal::thread_privatize;
+    auto body = thread_privatize(loop_body);
+    lws::detail::trace_next_loop(loop);
+    lws_for<Strategy>(ctx, iter, body.get_priv());
+  });
+
+  if (ctx != nullptr) {
+    vSched_context_release(ctx);
+  }
+}
+
+}  // closing brace for detail namespace
+
+///
+/// OpenMP lws policy implementations, for use inside a parallel region.
 ///
-  
 template <typename Iterable, typename Func>
-RAJA_INLINE void forall_impl(const omp_lws&,
+RAJA_INLINE void forall_impl(const omp_lws_for_exec&,
+                             Iterable&& iter,
+                             Func&& loop_body)
+{
+  detail::lws_forall_in_region<lws::statdynstaggered,
+                               detail::lws_runtime_fraction,
+                               0>(iter, loop_body);
+}
+
+template <typename Iterable,
+          typename Func,
+          typename Strategy,
+          int StaticFractionPercent,
+          int ChunkSize>
+RAJA_INLINE void forall_impl(
+    const omp_for_lws<Strategy, StaticFractionPercent, ChunkSize>&,
+    Iterable&& iter,
+    Func&& loop_body)
+{
+  detail::lws_forall_in_region<Strategy, StaticFractionPercent, ChunkSize>(
+      iter, loop_body);
+}
+
+///
+/// OpenMP parallel lws policy implementations.
+///
+template <typename Iterable, typename Func>
+RAJA_INLINE void forall_impl(const omp_lws&, Iterable&& iter, Func&& loop_body)
+{
+  detail::lws_forall_parallel<lws::statdynstaggered,
+                              detail::lws_runtime_fraction,
+                              0>(iter, loop_body);
+}
+
+template <typename Iterable,
+          typename Func,
+          typename Strategy,
+          int StaticFractionPercent,
+          int ChunkSize>
+RAJA_INLINE void forall_impl(
+    const omp_parallel_for_lws<Strategy, StaticFractionPercent, ChunkSize>&,
+    Iterable&& iter,
+    Func&& loop_body)
+{
+  detail::lws_forall_parallel<Strategy, StaticFractionPercent, ChunkSize>(
+      iter, loop_body);
+}
+
+///
+/// OpenMP parallel lws policy whose static fraction and chunk size are tuned
+/// for each call site. While a call site is tuning, every thread records
+/// when it finished, and the spread of the finish times and the number of
+/// steals are reported to the tuner after the loop.
+///
+template <typename Iterable, typename Func>
+RAJA_INLINE void forall_impl(const omp_lws_tuned&,
                              Iterable&& iter,
                              Func&& loop_body)
 {
   RAJA_EXTRACT_BED_IT(iter);
+  const lws::tuning_key key =
+      lws::make_tuning_key(loop_body, static_cast<long>(distance_it));
+  const lws::tuned_parameters params = lws::detail::tuning_begin(key);
+
+  vSched_context* ctx = vSched_context_acquire(omp_get_max_threads());
+  if (ctx == nullptr) {
+    forall_impl(omp_parallel_for_exec{}, iter, loop_body);
+    return;
+  }
+  vSched_context_set_static_fraction(ctx,
+                                     params.static_fraction,
+                                     params.chunk_size);
+
+  const lws::detail::trace_loop loop = lws::detail::trace_new_loop();
+  if (params.pinned || params.converged) {
+    RAJA::region<RAJA::omp_parallel_region>([&]() {
+      using RAJA::internal::thread_privatize;
+      auto body = thread_privatize(loop_body);
+      lws::detail::trace_next_loop(loop);
+      detail::lws_for<lws::statdynstaggered>(ctx, iter, body.get_priv());
+    });
+    vSched_context_release(ctx);
+    return;
+  }
+
+  std::vector<double> finish(omp_get_max_threads(), 0.0);
+  int numThreads = 1;
+  const double start = omp_get_wtime();
+  RAJA::region<RAJA::omp_parallel_region>([&]() {
+    using RAJA::internal::thread_privatize;
+    auto body = thread_privatize(loop_body);
+    lws::detail::trace_next_loop(loop);
+    detail::lws_for<lws::statdynstaggered>(ctx, iter, body.get_priv());
+    finish[omp_get_thread_num()] = omp_get_wtime();
+    if (omp_get_thread_num() == 0) {
+      numThreads = omp_get_num_threads();
+    }
+  });
+
+  const auto range = std::minmax_element(finish.begin(),
+                                         finish.begin() + numThreads);
+  const double elapsed = *range.second - start;
+  lws::detail::tuning_sample sample;
+  sample.skew = elapsed > 0.0 ? (*range.second - *range.first) / elapsed : 0.0;
+  sample.steals = vSched_context_steals(ctx);
+  sample.num_threads = numThreads;
+  vSched_context_release(ctx);
+  lws::detail::tuning_end(key, sample);
+}
+
+///
+/// OpenMP parallel lws policy that replays the iteration-to-thread
+/// assignment recorded in an earlier run of the call site.
+///
+template <typename Iterable, typename Func, int ImbalanceThresholdPercent>
+RAJA_INLINE void forall_impl(const omp_lws_sticky<ImbalanceThresholdPercent>&,
+                             Iterable&& iter,
+                             Func&& loop_body)
+{
+  RAJA_EXTRACT_BED_IT(iter);
+  const lws::tuning_key key =
+      lws::make_tuning_key(loop_body, static_cast<long>(distance_it));
+  lws::detail::sticky_schedule* schedule = lws::detail::sticky_acquire(key);
+  if (schedule == nullptr) {  // the call site is running on another thread
+    forall_impl(omp_lws{}, iter, loop_body);
+    return;
+  }
+
+  const int maxThreads = omp_get_max_threads();
+  vSched_context* ctx = vSched_context_acquire(maxThreads);
+  if (ctx == nullptr) {
+    lws::detail::sticky_release(schedule, lws::detail::sticky_outcome::none);
+    forall_impl(omp_parallel_for_exec{}, iter, loop_body);
+    return;
+  }
+  if (static_cast<int>(schedule->ranges.size()) < maxThreads) {
+    schedule->ranges.resize(maxThreads);
+  }
+
+  std::vector<double> finish(maxThreads, 0.0);
+  int numThreads = 1;
+  bool replayed = false;
+  const lws::detail::trace_loop loop = lws::detail::trace_new_loop();
+  const double start = omp_get_wtime();
+  RAJA::region<RAJA::omp_parallel_region>([&]() {
+    using RAJA::internal::thread_privatize;
+    auto body = thread_privatize(loop_body);
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+    lws::detail::trace_next_loop(loop);
+    // every thread sees the same team size, so they all take the same branch
+    if (schedule->recorded && schedule->num_threads == nthreads) {
+      detail::lws_for_replayed(
+          ctx, iter, body.get_priv(), schedule->ranges[tid]);
+    } else {
+      schedule->ranges[tid].clear();
+      detail::lws_for_recorded<lws::statdynstaggered>(
+          ctx, iter, body.get_priv(), schedule->ranges[tid]);
+    }
+    finish[tid] = omp_get_wtime();
+    if (tid == 0) {
+      replayed = schedule->recorded && schedule->num_threads == nthreads;
+      numThreads = nthreads;
+    }
+  });
+  vSched_context_release(ctx);
+
+  lws::detail::sticky_outcome outcome = lws::detail::sticky_outcome::recorded;
+  if (replayed) {
+    const auto range = std::minmax_element(finish.begin(),
+                                           finish.begin() + numThreads);
+    const double elapsed = *range.second - start;
+    outcome = (*range.second - *range.first
+               > elapsed * ImbalanceThresholdPercent / 100.0)
+                  ? lws::detail::sticky_outcome::imbalanced
+                  : lws::detail::sticky_outcome::replayed;
+  }
+  lws::detail::sticky_release(schedule, outcome, numThreads);
+}
+
+///
+/// OpenMP parallel lws policy that splits the loop by iteration cost. Costs
+/// given per iteration are summed into a prefix in the parallel region
+/// first, one block per thread.
+///
+template <typename Iterable, typename Func, typename T>
+RAJA_INLINE void forall_impl(const omp_lws_weighted<T>& p,
+                             Iterable&& iter,
+                             Func&& loop_body)
+{
+  RAJA_EXTRACT_BED_IT(iter);
+  const int n = static_cast<int>(distance_it);
+  const int maxThreads = omp_get_max_threads();
+  vSched_context* ctx = vSched_context_acquire(maxThreads);
+  if (ctx == nullptr) {
+    forall_impl(omp_parallel_for_exec{}, iter, loop_body);
+    return;
+  }
+
+  std::vector<double> prefix(p.costs.is_prefix ? 0 : n + 1);
+  std::vector<double> sums(p.costs.is_prefix ? 0 : maxThreads);
+  const lws::detail::trace_loop loop = lws::detail::trace_new_loop();
+  RAJA::region<RAJA::omp_parallel_region>([&]() {
+    using RAJA::internal::thread_privatize;
+    auto body = thread_privatize(loop_body);
+    const int tid = omp_get_thread_num();
+    const int nthreads = omp_get_num_threads();
+    if (!p.costs.is_prefix) {
+      sums[tid] =
+          lws::detail::weighted_block_sum(p.costs.data, n, tid, nthreads);
+#pragma omp barrier
+      double offset = 0.0;
+      for (int t = 0; t < tid; ++t) {
+        offset += sums[t];
+      }
+      lws::detail::weighted_block_prefix(
+          p.costs.data, n, tid, nthreads, offset, prefix.data());
+#pragma omp barrier
+    }
+    lws::detail::cost_map<T> map(p.costs, prefix.data(), n);
+    lws::detail::trace_next_loop(loop);
+    lws::detail::lws_for_thread_weighted<lws::statdynstaggered>(
+        ctx, iter, map, body.get_priv(), tid, nthreads);
+  });
+  vSched_context_release(ctx);
+}
+
+namespace detail
+{
+
+///
+/// Runs the calling thread's part of an omp_lws_team_depend_exec loop: every
+/// chunk waits for the iterations it depends on in the previous team loop,
+/// and records its iterations as finished for the next one.
+///
+template <int Halo, typename Iterable, typename Func>
+RAJA_INLINE void lws_for_team_depend(lws::detail::team_thread& self,
+                                     vSched_context* ctx,
+                                     int context,
+                                     Iterable&& iter,
+                                     Func&& loop_body)
+{
+  using strategy = LwsStrategy<lws::statdynstaggered>;
+  RAJA_EXTRACT_BED_IT(iter);
+  const int n = static_cast<int>(distance_it);
+  const int threadNum = omp_get_thread_num();
   int startInd, endInd;
-  int threadNum = omp_get_thread_num();
-  int numThreads = omp_get_num_threads();
-  // vSched_Init<Func>(numThreads);  // consider templating function. 
+  lws::detail::team_depend_loop loop(self, context, n);
+
+  strategy::start(
+      ctx, 0, n, &startInd, &endInd, threadNum, omp_get_num_threads());
+  lws::detail::body_timer timer;
+  lws::detail::chunk_tracer trace(threadNum);
+  do {
+    if (startInd < endInd) {
+      loop.wait_for(static_cast<long>(startInd) - Halo,
+                    static_cast<long>(endInd) + Halo);
+      trace.start(startInd, endInd);
+      timer.start();
+      for (decltype(distance_it) i = startInd; i < endInd; ++i) {
+        loop_body(begin_it[i]);
+      }
+      timer.stop();
+      trace.stop();
+      loop.finished(startInd, endInd);
+    }
+  } while (strategy::next(ctx, &startInd, &endInd, threadNum));
+  loop.end();
+}
 
-//   FORALL_BEGIN(statdynstaggered, 0, distance_it, startInd, endInd, threadNum, numThreads)
-    
-  loop_start_statdynstaggered(0, distance_it ,&startInd, &endInd, threadNum, numThreads);  do {
-  for (decltype(distance_it) i = startInd; i < endInd; ++i) {
-    loop_body(begin_it[i]);
+}  // closing brace for detail namespace
+
+///
+/// lws loops of an omp_lws_region team, which runs them with the scheduler
+/// contexts it acquired for the region.
+///
+template <typename Iterable, typename Func>
+RAJA_INLINE void forall_impl(const omp_lws_team_exec&,
+                             Iterable&& iter,
+                             Func&& loop_body)
+{
+  lws::detail::team_thread* self = lws::detail::current_team_thread();
+  if (self == nullptr) {
+    forall_impl(omp_lws_for_exec{}, iter, loop_body);
+    return;
   }
-  while( loop_next_statdynstaggered(&startInd, &endInd, tid));
-    // vSched_Finalize();
+  // the loop may read anything the loop before it wrote
+  lws::detail::team_wait_last_loop(*self);
+  int context;
+  vSched_context* ctx = lws::detail::team_loop_begin(*self, &context);
+  detail::lws_for<lws::statdynstaggered>(ctx, iter, loop_body);
+  lws::detail::team_loop_end(
+      *self, context, lws::detail::team_after::barrier);
+#pragma omp barrier
 }
+
+///
+/// The team loops without a barrier return the handle of the loop, for
+/// RAJA::lws::forall_async; outside a team region the loop ends with a
+/// barrier and the handle is a finished one.
+///
+template <typename Iterable, typename Func>
+RAJA_INLINE lws::loop_handle forall_async_impl(
+    const omp_lws_team_nowait_exec&,
+    Iterable&& iter,
+    Func&& loop_body)
+{
+  lws::detail::team_thread* self = lws::detail::current_team_thread();
+  if (self == nullptr) {
+    forall_impl(omp_lws_for_exec{}, iter, loop_body);
+    return lws::loop_handle();
+  }
+  lws::detail::team_wait_last_loop(*self);
+  int context;
+  vSched_context* ctx = lws::detail::team_loop_begin(*self, &context);
+  detail::lws_for<lws::statdynstaggered>(ctx, iter, loop_body);
+  lws::detail::team_loop_end(*self, context);
+  return lws::detail::team_last_loop(*self);
+}
+
+template <typename Iterable, typename Func, int Halo>
+RAJA_INLINE lws::loop_handle forall_async_impl(
+    const omp_lws_team_depend_exec<Halo>&,
+    Iterable&& iter,
+    Func&& loop_body)
+{
+  lws::detail::team_thread* self = lws::detail::current_team_thread();
+  if (self == nullptr) {
+    forall_impl(omp_lws_for_exec{}, iter, loop_body);
+    return lws::loop_handle();
+  }
+  lws::detail::team_wait_last_loop(*self, true);
+  int context;
+  vSched_context* ctx = lws::detail::team_loop_begin(*self, &context);
+  detail::lws_for_team_depend<Halo>(*self, ctx, context, iter, loop_body);
+  return lws::detail::team_last_loop(*self);
+}
+
+template <typename Iterable, typename Func>
+RAJA_INLINE void forall_impl(const omp_lws_team_nowait_exec& p,
+                             Iterable&& iter,
+                             Func&& loop_body)
+{
+  forall_async_impl(p, iter, loop_body);
+}
+
+template <typename Iterable, typename Func, int Halo>
+RAJA_INLINE void forall_impl(const omp_lws_team_depend_exec<Halo>& p,
+                             Iterable&& iter,
+                             Func&& loop_body)
+{
+  forall_async_impl(p, iter, loop_body);
+}
+
 ///
 /// OpenMP parallel for static policy implementation
 ///  
-template <typename Iterable, typename Func, size_t ChunkSize>
+template <typename Iterable, typename Func, unsigned int ChunkSize>
 RAJA_INLINE void forall_impl(const omp_for_static<ChunkSize>&,
                              Iterable&& iter,
                              Func&& loop_body)
 {
   RAJA_EXTRACT_BED_IT(iter);
-#pragma omp for schedule(static, ChunkSize)
+  lws::detail::iteration_tracer trace(detail::trace_region_loop(),
+                                      omp_get_thread_num());
+#pragma omp for schedule(static, ChunkSize) nowait
   for (decltype(distance_it) i = 0; i < distance_it; ++i) {
+    trace.visit(i);
     loop_body(begin_it[i]);
   }
+  trace.end();
+#pragma omp barrier
 }
 
 //
@@ -163,6 +729,181 @@ RAJA_INLINE void forall_impl(const omp_for_static<ChunkSize>&,
 //////////////////////////////////////////////////////////////////////
 //
 
+namespace detail
+{
+
+///
+/// Segment call that reports the length of a segment and whether an lws
+/// chunk may run part of it.
+///
+struct LwsSegmentInfo {
+  template <typename Segment>
+  RAJA_INLINE void operator()(Segment const& segment,
+                              long* length,
+                              bool* splittable) const
+  {
+    using std::begin;
+    using std::end;
+    using std::distance;
+    *length = static_cast<long>(distance(begin(segment), end(segment)));
+    *splittable = false;
+  }
+
+  template <typename StorageT, typename DiffT>
+  RAJA_INLINE void operator()(TypedRangeSegment<StorageT, DiffT> const& segment,
+                              long* length,
+                              bool* splittable) const
+  {
+    *length = static_cast<long>(segment.size());
+    *splittable = true;
+  }
+};
+
+///
+/// Segment call that runs the iterations [first, last) of a RangeSegment,
+/// or all of a segment of another type.
+///
+struct LwsCallSlice {
+  long first;
+  long last;
+
+  template <typename Segment, typename ExecPolicy, typename Body>
+  RAJA_INLINE void operator()(Segment const& segment,
+                              ExecPolicy,
+                              Body& body) const
+  {
+    using policy::sequential::forall_impl;
+    forall_impl(ExecPolicy(), segment, body);
+  }
+
+  template <typename StorageT,
+            typename DiffT,
+            typename ExecPolicy,
+            typename Body>
+  RAJA_INLINE void operator()(TypedRangeSegment<StorageT, DiffT> const& segment,
+                              ExecPolicy,
+                              Body& body) const
+  {
+    using policy::sequential::forall_impl;
+    forall_impl(ExecPolicy(), segment.slice(first, last - first), body);
+  }
+};
+
+///
+/// Runs the part of an index set that lies in [first, last) of its iteration
+/// space; starts[s] is where segment s begins.
+///
+template <typename SegmentExecPolicy, typename Func, typename... SegmentTypes>
+RAJA_INLINE void lws_run_segments(const TypedIndexSet<SegmentTypes...>& iset,
+                                  const std::vector<long>& starts,
+                                  const std::vector<char>& splittable,
+                                  long first,
+                                  long last,
+                                  Func& loop_body)
+{
+  const int num_seg = static_cast<int>(splittable.size());
+  int seg = static_cast<int>(
+      std::upper_bound(starts.begin(), starts.end(), first) - starts.begin()
+      - 1);
+  for (; seg < num_seg && starts[seg] < last; ++seg) {
+    if (splittable[seg]) {
+      iset.segmentCall(seg,
+                       LwsCallSlice{std::max(first, starts[seg]) - starts[seg],
+                                    std::min(last, starts[seg + 1])
+                                        - starts[seg]},
+                       SegmentExecPolicy(),
+                       loop_body);
+    } else if (starts[seg] >= first && starts[seg] < starts[seg + 1]) {
+      iset.segmentCall(seg,
+                       LwsCallSlice{0, starts[seg + 1] - starts[seg]},
+                       SegmentExecPolicy(),
+                       loop_body);
+    }
+  }
+}
+
+}  // closing brace for detail namespace
+
+///
+/// OpenMP lws segment iteration. Used on its own over a container of
+/// segment ids (as forall_Icount does), it schedules the ids like omp_lws.
+///
+template <typename Iterable, typename Func>
+RAJA_INLINE void forall_impl(const omp_lws_segit&,
+                             Iterable&& iter,
+                             Func&& loop_body)
+{
+  detail::lws_forall_parallel<lws::statdynstaggered,
+                              detail::lws_runtime_fraction,
+                              0>(iter, loop_body);
+}
+
+///
+/// OpenMP lws iteration over the segments of an index set, scheduling the
+/// iterations of all segments as one loop.
+///
+template <typename SegmentExecPolicy,
+          typename LoopBody,
+          typename... SegmentTypes>
+RAJA_INLINE void forall_segments(const omp_lws_segit&,
+                                 SegmentExecPolicy,
+                                 const TypedIndexSet<SegmentTypes...>& iset,
+                                 LoopBody loop_body)
+{
+  const int num_seg = iset.getNumSegments();
+  std::vector<long> starts(num_seg + 1, 0);
+  std::vector<char> splittable(num_seg, 0);
+  for (int seg = 0; seg < num_seg; ++seg) {
+    long length = 0;
+    bool split = false;
+    iset.segmentCall(seg, detail::LwsSegmentInfo{}, &length, &split);
+    starts[seg + 1] = starts[seg] + length;
+    splittable[seg] = split;
+  }
+  const long total = starts[num_seg];
+
+  // vSched schedules int iteration spaces
+  vSched_context* ctx = nullptr;
+  if (total <= std::numeric_limits<int>::max()) {
+    ctx = detail::lws_acquire<lws::statdynstaggered,
+                              detail::lws_runtime_fraction,
+                              0>(omp_get_max_threads());
+  }
+  if (ctx == nullptr) {
+    wrap::forall_segments(omp_parallel_for_segit{},
+                          SegmentExecPolicy(),
+                          iset,
+                          loop_body);
+    return;
+  }
+
+  using strategy = detail::LwsStrategy<lws::statdynstaggered>;
+  RAJA::region<RAJA::omp_parallel_region>([&]() {
+    using RAJA::internal::thread_privatize;
+    auto body = thread_privatize(loop_body);
+    int startInd, endInd;
+    int threadNum = omp_get_thread_num();
+    int numThreads = omp_get_num_threads();
+
+    strategy::start(ctx,
+                    0,
+                    static_cast<int>(total),
+                    &startInd,
+                    &endInd,
+                    threadNum,
+                    numThreads);
+    lws::detail::body_timer timer;
+    do {
+      timer.start();
+      detail::lws_run_segments<SegmentExecPolicy>(
+          iset, starts, splittable, startInd, endInd, body.get_priv());
+      timer.stop();
+    } while (strategy::next(ctx, &startInd, &endInd, threadNum));
+  });
+
+  vSched_context_release(ctx);
+}
+
 /*!
  ******************************************************************************
  *
@@ -229,6 +970,37 @@ RAJA_INLINE void forall(
 
 }  // closing brace for policy namespace
 
+namespace lws
+{
+
+/*!
+ * \brief Runs the calling thread's part of a team loop without a barrier
+ *        and returns the handle of the loop, so that the thread can do
+ *        other work before it waits for the rest of the team, e.g.
+ *
+ * \code
+ *
+ * RAJA::region<RAJA::omp_lws_region>([=]() {
+ *   auto pressure = RAJA::lws::forall_async<RAJA::omp_lws_team_nowait_exec>(
+ *       range, compute_pressure);
+ *   ...
+ *   pressure.wait();
+ * });
+ *
+ * \endcode
+ *
+ *        ExecPolicy is omp_lws_team_nowait_exec or omp_lws_team_depend_exec.
+ */
+template <typename ExecPolicy, typename Container, typename LoopBody>
+RAJA_INLINE loop_handle forall_async(Container&& c, LoopBody&& loop_body)
+{
+  return policy::omp::forall_async_impl(ExecPolicy{},
+                                        std::forward<Container>(c),
+                                        std::forward<LoopBody>(loop_body));
+}
+
+}  // closing brace for lws namespace
+
 }  // closing brace for RAJA namespace
 
 #endif  // closing endif for if defined(RAJA_ENABLE_OPENMP)
@@ -30,6 +30,7 @@
 
 #if defined(RAJA_ENABLE_OPENMP)
 
+#include <algorithm>
 #include <cassert>
 #include <climits>
 
@@ -39,6 +40,7 @@
 #include "RAJA/util/macros.hpp"
 #include "RAJA/util/types.hpp"
 
+#include "RAJA/policy/openmp/forall.hpp"
 #include "RAJA/policy/openmp/policy.hpp"
 
 #include "RAJA/internal/LegacyCompatibility.hpp"
@@ -53,6 +55,17 @@ struct omp_parallel_collapse_exec
                             RAJA::policy::omp::For> {
 };
 
+///
+/// Collapses the loops into tiles of about lws_collapse_tile_iterations
+/// iterations that are scheduled like the iterations of omp_lws: the static
+/// fraction and the chunk size (in tiles) are set with setStaticFraction().
+///
+struct omp_lws_collapse_exec
+    : make_policy_pattern_t<RAJA::Policy::openmp,
+                            RAJA::Pattern::forall,
+                            RAJA::policy::omp::Lws> {
+};
+
 namespace internal
 {
 
@@ -138,6 +151,201 @@ struct StatementExecutor<statement::Collapse<omp_parallel_collapse_exec,
   }
 };
 
+/////////
+// lws scheduling of collapsed loops
+/////////
+
+/// iterations in a tile, and the extent of a tile in the innermost loop
+constexpr long lws_collapse_tile_iterations = 256;
+constexpr long lws_collapse_tile_inner = 32;
+
+///
+/// Runs one thread's share of numTiles tiles scheduled by ctx, calling
+/// run_tiles(first, last) for every chunk of tile ids it gets.
+///
+template <typename RunTiles>
+RAJA_INLINE void lws_collapse_for(vSched_context* ctx,
+                                  long numTiles,
+                                  RunTiles&& run_tiles)
+{
+  using strategy = policy::omp::detail::LwsStrategy<lws::statdynstaggered>;
+  int startInd, endInd;
+  int threadNum = omp_get_thread_num();
+  int numThreads = omp_get_num_threads();
+
+  strategy::start(ctx,
+                  0,
+                  static_cast<int>(numTiles),
+                  &startInd,
+                  &endInd,
+                  threadNum,
+                  numThreads);
+  lws::detail::body_timer timer;
+  do {
+    timer.start();
+    if (startInd < endInd) {
+      run_tiles(static_cast<long>(startInd), static_cast<long>(endInd));
+    }
+    timer.stop();
+  } while (strategy::next(ctx, &startInd, &endInd, threadNum));
+}
+
+/// scheduler context for numTiles tiles, or nullptr if vSched cannot take them
+RAJA_INLINE vSched_context* lws_collapse_acquire(long numTiles)
+{
+  if (numTiles > INT_MAX) {
+    return nullptr;
+  }
+  return policy::omp::detail::lws_acquire<
+      lws::statdynstaggered,
+      policy::omp::detail::lws_runtime_fraction,
+      0>(omp_get_max_threads());
+}
+
+template <camp::idx_t Arg0, camp::idx_t Arg1, typename... EnclosedStmts>
+struct StatementExecutor<statement::Collapse<omp_lws_collapse_exec,
+                                             ArgList<Arg0, Arg1>,
+                                             EnclosedStmts...>> {
+
+
+  template <typename Data>
+  static RAJA_INLINE void exec(Data&& data)
+  {
+
+    using data_t = camp::decay<Data>;
+
+    const long l0 = segment_length<Arg0>(data);
+    const long l1 = segment_length<Arg1>(data);
+    if (l0 <= 0 || l1 <= 0) {
+      return;
+    }
+
+    // tile extents and tile counts per loop
+    const long t1 = std::min(l1, lws_collapse_tile_inner);
+    const long t0 =
+        std::min(l0, std::max(1L, lws_collapse_tile_iterations / t1));
+    const long n1 = (l1 + t1 - 1) / t1;
+    const long n0 = (l0 + t0 - 1) / t0;
+
+    vSched_context* ctx = lws_collapse_acquire(n0 * n1);
+    if (ctx == nullptr) {
+      StatementExecutor<statement::Collapse<omp_parallel_collapse_exec,
+                                            ArgList<Arg0, Arg1>,
+                                            EnclosedStmts...>>::exec(data);
+      return;
+    }
+
+#pragma omp parallel
+    {
+      data_t private_data = data;
+
+      lws_collapse_for(ctx, n0 * n1, [&](long first, long last) {
+        // decode the first tile of the chunk, then step to the next ones
+        long tile0 = first / n1;
+        long tile1 = first - tile0 * n1;
+        for (long tile = first; tile < last; ++tile) {
+          const long e0 = std::min(l0, (tile0 + 1) * t0);
+          const long e1 = std::min(l1, (tile1 + 1) * t1);
+          for (long i0 = tile0 * t0; i0 < e0; ++i0) {
+            for (long i1 = tile1 * t1; i1 < e1; ++i1) {
+              private_data.template assign_offset<Arg0>(i0);
+              private_data.template assign_offset<Arg1>(i1);
+              execute_statement_list<camp::list<EnclosedStmts...>>(
+                  private_data);
+            }
+          }
+          if (++tile1 == n1) {
+            tile1 = 0;
+            ++tile0;
+          }
+        }
+      });
+    }
+
+    vSched_context_release(ctx);
+  }
+};
+
+
+template <camp::idx_t Arg0,
+          camp::idx_t Arg1,
+          camp::idx_t Arg2,
+          typename... EnclosedStmts>
+struct StatementExecutor<statement::Collapse<omp_lws_collapse_exec,
+                                             ArgList<Arg0, Arg1, Arg2>,
+                                             EnclosedStmts...>> {
+
+
+  template <typename Data>
+  static RAJA_INLINE void exec(Data&& data)
+  {
+
+    using data_t = camp::decay<Data>;
+
+    const long l0 = segment_length<Arg0>(data);
+    const long l1 = segment_length<Arg1>(data);
+    const long l2 = segment_length<Arg2>(data);
+    if (l0 <= 0 || l1 <= 0 || l2 <= 0) {
+      return;
+    }
+
+    // tile extents and tile counts per loop
+    const long t2 = std::min(l2, lws_collapse_tile_inner);
+    const long t1 =
+        std::min(l1, std::max(1L, lws_collapse_tile_iterations / t2));
+    const long t0 =
+        std::min(l0, std::max(1L, lws_collapse_tile_iterations / (t1 * t2)));
+    const long n2 = (l2 + t2 - 1) / t2;
+    const long n1 = (l1 + t1 - 1) / t1;
+    const long n0 = (l0 + t0 - 1) / t0;
+
+    vSched_context* ctx = lws_collapse_acquire(n0 * n1 * n2);
+    if (ctx == nullptr) {
+      StatementExecutor<statement::Collapse<omp_parallel_collapse_exec,
+                                            ArgList<Arg0, Arg1, Arg2>,
+                                            EnclosedStmts...>>::exec(data);
+      return;
+    }
+
+#pragma omp parallel
+    {
+      data_t private_data = data;
+
+      lws_collapse_for(ctx, n0 * n1 * n2, [&](long first, long last) {
+        // decode the first tile of the chunk, then step to the next ones
+        long tile0 = first / (n1 * n2);
+        long tile1 = (first - tile0 * n1 * n2) / n2;
+        long tile2 = first - (tile0 * n1 + tile1) * n2;
+        for (long tile = first; tile < last; ++tile) {
+          const long e0 = std::min(l0, (tile0 + 1) * t0);
+          const long e1 = std::min(l1, (tile1 + 1) * t1);
+          const long e2 = std::min(l2, (tile2 + 1) * t2);
+          for (long i0 = tile0 * t0; i0 < e0; ++i0) {
+            for (long i1 = tile1 * t1; i1 < e1; ++i1) {
+              for (long i2 = tile2 * t2; i2 < e2; ++i2) {
+                private_data.template assign_offset<Arg0>(i0);
+                private_data.template assign_offset<Arg1>(i1);
+                private_data.template assign_offset<Arg2>(i2);
+                execute_statement_list<camp::list<EnclosedStmts...>>(
+                    private_data);
+              }
+            }
+          }
+          if (++tile2 == n2) {
+            tile2 = 0;
+            if (++tile1 == n1) {
+              tile1 = 0;
+              ++tile0;
+            }
+          }
+        }
+      });
+    }
+
+    vSched_context_release(ctx);
+  }
+};
+
 
 }  // namespace internal
 }  // namespace RAJA
@@ -0,0 +1,268 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file for running an lws loop with delays injected into its
+ *          chunks, to measure how well a strategy and static fraction
+ *          tolerate noise such as OS jitter or a slow core.
+ *
+ *          The delays are busy waits decided by a seeded schedule, so a run
+ *          can be repeated and needs no special privileges.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_noise_openmp_HPP
+#define RAJA_lws_noise_openmp_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP)
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <omp.h>
+
+#include "RAJA/pattern/detail/forall.hpp"
+#include "RAJA/pattern/forall.hpp"
+
+#include "RAJA/policy/lws/schedule.hpp"
+#include "RAJA/policy/openmp/vSched_internal.h"
+
+namespace RAJA
+{
+namespace lws
+{
+
+enum class noise_kind {
+  none,
+  periodic,    // each thread is interrupted at a fixed period
+  random,      // each thread is interrupted at random, at a given mean period
+  slow_thread  // the chunks of one thread take slowdown times as long
+};
+
+/*!
+ * \brief The delays injected into the chunks of a loop run with
+ *        forall_with_noise. Interruptions happen at points of the time a
+ *        thread spends running iterations, which only depend on the seed and
+ *        the thread, and hold up the chunk they fall in.
+ */
+struct noise_model {
+  noise_kind kind = noise_kind::none;
+  double period = 0.0;  // seconds between interruptions (mean for random)
+  double delay = 0.0;   // seconds an interruption lasts
+  int thread = 0;       // slow_thread
+  double slowdown = 1.0;
+  std::uint64_t seed = 0;
+};
+
+inline noise_model periodic_noise(double period,
+                                  double delay,
+                                  std::uint64_t seed = 0)
+{
+  noise_model m;
+  m.kind = noise_kind::periodic;
+  m.period = period;
+  m.delay = delay;
+  m.seed = seed;
+  return m;
+}
+
+inline noise_model random_noise(double period,
+                                double delay,
+                                std::uint64_t seed = 0)
+{
+  noise_model m;
+  m.kind = noise_kind::random;
+  m.period = period;
+  m.delay = delay;
+  m.seed = seed;
+  return m;
+}
+
+inline noise_model slow_thread_noise(int thread, double slowdown)
+{
+  noise_model m;
+  m.kind = noise_kind::slow_thread;
+  m.thread = thread;
+  m.slowdown = slowdown;
+  return m;
+}
+
+/*!
+ * \brief The noise of one thread, chunk after chunk.
+ */
+class thread_noise
+{
+public:
+  thread_noise(const noise_model& model, int tid) : m_model(model), m_tid(tid)
+  {
+    if ((model.kind == noise_kind::periodic
+         || model.kind == noise_kind::random)
+        && model.period > 0.0) {
+      // the first interruption of each thread comes at a different time
+      m_next = uniform(-1) * model.period;
+    }
+  }
+
+  /*!
+   * \brief Seconds that the next chunk of the thread is held up, given that
+   *        its iterations took body seconds.
+   */
+  double delay(double body)
+  {
+    if (m_model.kind == noise_kind::slow_thread) {
+      return (m_tid == m_model.thread) ? (m_model.slowdown - 1.0) * body : 0.0;
+    }
+    const double end = m_busy + body;
+    int interruptions = 0;
+    while (m_next < end) {
+      ++interruptions;
+      ++m_count;
+      m_next += (m_model.kind == noise_kind::periodic)
+                    ? m_model.period
+                    : -std::log(1.0 - uniform(m_count)) * m_model.period;
+    }
+    m_busy = end;
+    return interruptions * m_model.delay;
+  }
+
+private:
+  // uniform in [0, 1), a function of seed, thread and k
+  double uniform(long k) const
+  {
+    return vSched_uniform(
+        m_model.seed ^ (static_cast<std::uint64_t>(m_tid) << 32)
+        ^ (static_cast<std::uint64_t>(k) * 0x9E3779B97F4A7C15ULL));
+  }
+
+  noise_model m_model;
+  int m_tid;
+  double m_busy = 0.0;  // seconds of iterations run so far
+  double m_next = std::numeric_limits<double>::infinity();
+  long m_count = 0;
+};
+
+/*!
+ * \brief What a loop run with forall_with_noise cost. Times are in seconds
+ *        and summed over the threads, except for the makespan.
+ */
+struct noise_report {
+  int threads = 0;
+  double makespan = 0.0;  // from the start of the loop to its end
+  double busy = 0.0;      // running iterations
+  double delayed = 0.0;   // held up by the injected noise
+  double idle = 0.0;      // anything else: dequeues, waiting for the others
+  long chunks = 0;        // non-empty chunks run
+  int steals = 0;         // successful steals, statdynstaggered only
+};
+
+namespace detail
+{
+
+inline void spin_until(double t)
+{
+  while (vSched_now() < t) {
+  }
+}
+
+}  // closing brace for detail namespace
+
+/*!
+ * \brief Runs an lws loop with Strategy, staticFraction and chunkSize in its
+ *        own parallel region, holding up its chunks as noise says, and
+ *        reports where the time went. Like the lws policies, it falls back
+ *        to a static schedule if no scheduler context is left.
+ */
+template <typename Strategy, typename Iterable, typename Func>
+noise_report forall_with_noise(const noise_model& noise,
+                               float staticFraction,
+                               int chunkSize,
+                               Iterable&& iter,
+                               Func&& loop_body)
+{
+  using strategy = detail::LwsStrategy<Strategy>;
+  noise_report report;
+  vSched_context* ctx = nullptr;
+  if (strategy::needs_context) {
+    ctx = vSched_context_acquire(omp_get_max_threads());
+    if (ctx == nullptr) {  // the pool and the heap are exhausted
+      return forall_with_noise<static_schedule>(
+          noise, staticFraction, chunkSize, iter, loop_body);
+    }
+    vSched_context_set_static_fraction(ctx, staticFraction, chunkSize);
+  }
+
+  RAJA_EXTRACT_BED_IT(iter);
+  const int n = static_cast<int>(distance_it);
+  int threads = 1;
+  double busy = 0.0, delayed = 0.0;
+  long chunks = 0;
+  const double start = vSched_now();
+#pragma omp parallel reduction(+ : busy, delayed, chunks)
+  {
+    using RAJA::internal::thread_privatize;
+    auto body = thread_privatize(loop_body);
+    const int tid = omp_get_thread_num();
+    thread_noise delays(noise, tid);
+    long chunk = 0;
+    int startInd, endInd;
+#pragma omp master
+    threads = omp_get_num_threads();
+
+    strategy::start(
+        ctx, 0, n, &startInd, &endInd, tid, omp_get_num_threads());
+    do {
+      if (startInd < endInd) {
+        const double t0 = vSched_now();
+        for (decltype(distance_it) i = startInd; i < endInd; ++i) {
+          body.get_priv()(begin_it[i]);
+        }
+        const double t1 = vSched_now();
+        const double d = delays.delay(t1 - t0);
+        detail::spin_until(t1 + d);
+        ++chunk;
+        busy += t1 - t0;
+        delayed += d;
+      }
+    } while (strategy::next(ctx, &startInd, &endInd, tid));
+    chunks += chunk;
+  }
+  report.makespan = vSched_now() - start;
+
+  report.threads = threads;
+  report.busy = busy;
+  report.delayed = delayed;
+  report.idle = report.makespan * threads - busy - delayed;
+  report.chunks = chunks;
+  if (ctx != nullptr) {
+    report.steals = vSched_context_steals(ctx);
+    vSched_context_release(ctx);
+  }
+  return report;
+}
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for if defined(RAJA_ENABLE_OPENMP)
+
+#endif  // closing endif for header file include guard
@@ -0,0 +1,105 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file for the lws scheduler statistics.
+ *
+ *          Statistics are only collected when RAJA is configured with
+ *          ENABLE_LWS_STATS; otherwise the recording compiles to nothing
+ *          and get_stats() returns zeros.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_stats_openmp_HPP
+#define RAJA_lws_stats_openmp_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP) || defined(RAJA_ENABLE_LWS_THREADS)
+
+#include "RAJA/policy/openmp/vSched_internal.h"
+
+namespace RAJA
+{
+namespace lws
+{
+
+/*!
+ * \brief Scheduler statistics summed over all threads, see vSched_stats.
+ */
+using stats = vSched_stats;
+
+#if defined(RAJA_ENABLE_LWS_STATS)
+constexpr bool stats_enabled = true;
+#else
+constexpr bool stats_enabled = false;
+#endif
+
+/*!
+ * \brief Returns the statistics recorded since the last reset_stats().
+ *        Call it between loops; counts of running loops may be partial.
+ */
+inline stats get_stats()
+{
+  stats s;
+  vSched_get_stats(&s);
+  return s;
+}
+
+inline void reset_stats() { vSched_reset_stats(); }
+
+namespace detail
+{
+
+/*!
+ * \brief Times the loop body chunks of one thread in one loop.
+ */
+#if defined(RAJA_ENABLE_LWS_STATS)
+class body_timer
+{
+public:
+  ~body_timer() { vSched_stats_add_body_time(m_total); }
+
+  void start() { m_start = vSched_now(); }
+
+  void stop() { m_total += vSched_now() - m_start; }
+
+private:
+  double m_start = 0.0;
+  double m_total = 0.0;
+};
+#else
+class body_timer
+{
+public:
+  void start() {}
+
+  void stop() {}
+};
+#endif
+
+}  // closing brace for detail namespace
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for RAJA_ENABLE_OPENMP or RAJA_ENABLE_LWS_THREADS
+
+#endif  // closing endif for header file include guard
@@ -0,0 +1,107 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file for the schedules that the omp_lws_sticky policy
+ *          keeps between the runs of a loop.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_sticky_openmp_HPP
+#define RAJA_lws_sticky_openmp_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP)
+
+#include <utility>
+#include <vector>
+
+#include "RAJA/policy/openmp/lws_tuning.hpp"
+
+namespace RAJA
+{
+namespace lws
+{
+
+/*!
+ * \brief What happened to the sticky schedule of a call site so far.
+ */
+struct sticky_info {
+  int recordings;  // runs that scheduled dynamically and recorded the result
+  int replays;     // runs that replayed the recorded schedule
+  bool recorded;   // the next run replays
+};
+
+/*!
+ * \brief Returns the sticky schedule state of a call site (a call site is
+ *        keyed as for tuning, see make_tuning_key()).
+ */
+sticky_info get_sticky_info(const tuning_key& key);
+
+/*!
+ * \brief Forgets every recorded schedule, so the next run of each call site
+ *        schedules dynamically again.
+ */
+void reset_sticky_schedules();
+
+namespace detail
+{
+
+/*!
+ * \brief The iterations each thread ran in the last recorded run of a call
+ *        site, as ranges [first, second) of positions in the iteration space.
+ */
+struct sticky_schedule {
+  std::vector<std::vector<std::pair<long, long>>> ranges;
+  int num_threads;
+  bool recorded;
+  bool in_use;
+  bool reset_pending;  // reset_sticky_schedules() ran while it was in use
+  int recordings;
+  int replays;
+};
+
+/// What a run of the loop of a call site did with its schedule.
+enum class sticky_outcome {
+  none,       // the loop did not use it
+  recorded,   // it scheduled dynamically and recorded the assignment
+  replayed,   // it replayed the assignment
+  imbalanced  // it replayed the assignment, which was too imbalanced to keep
+};
+
+/// the schedule of a call site, or nullptr if another loop is using it;
+/// only the loop that has it writes it until it is released
+sticky_schedule* sticky_acquire(const tuning_key& key);
+
+/// gives the schedule back, counting the run; num_threads is the team size
+/// of a recording run
+void sticky_release(sticky_schedule* schedule,
+                    sticky_outcome outcome,
+                    int num_threads = 0);
+
+}  // closing brace for detail namespace
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for if defined(RAJA_ENABLE_OPENMP)
+
+#endif  // closing endif for header file include guard
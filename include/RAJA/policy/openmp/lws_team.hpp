@@ -0,0 +1,360 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file for the scheduler state that the team of an
+ *          omp_lws_region shares between its lws loops.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_team_openmp_HPP
+#define RAJA_lws_team_openmp_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP)
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include <omp.h>
+
+#include "RAJA/policy/openmp/lws_trace.hpp"
+#include "RAJA/policy/openmp/vSched_internal.h"
+
+namespace RAJA
+{
+namespace lws
+{
+
+///
+/// Completion of a team loop that the threads of the team left without a
+/// barrier, see forall_async. Only valid inside the team's region.
+///
+class loop_handle
+{
+public:
+  /// the handle of a loop that is already finished
+  loop_handle() = default;
+
+  loop_handle(const std::atomic<long>* threads, long target)
+      : m_threads(threads), m_target(target)
+  {
+  }
+
+  /// whether every thread of the team finished its part of the loop
+  bool done() const
+  {
+    return m_threads == nullptr
+           || m_threads->load(std::memory_order_acquire) >= m_target;
+  }
+
+  void wait() const
+  {
+    while (!done()) {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  const std::atomic<long>* m_threads = nullptr;
+  long m_target = 0;
+};
+
+namespace detail
+{
+
+///
+/// Contexts a team cycles through. A loop can start on one while threads
+/// are still stealing in the previous loop, which uses the other.
+///
+constexpr int team_contexts = 2;
+
+///
+/// Blocks a dependent team loop is split into to record its progress; a
+/// loop that depends on it waits for the blocks its chunks read.
+///
+constexpr int team_blocks = 64;
+
+struct team {
+  struct alignas(VSCHED_CACHE_LINE) done_count {
+    std::atomic<long> threads;  // threads that finished a loop on the context
+  };
+
+  struct alignas(VSCHED_CACHE_LINE) block_count {
+    // iterations of the block finished, summed over the dependent loops
+    // that ran on the context
+    std::atomic<long> iterations;
+  };
+
+  vSched_context* ctx[team_contexts];
+  done_count done[team_contexts];
+  block_count blocks[team_contexts][team_blocks];
+  trace_loop trace;  // the loops of the team are its steps
+};
+
+///
+/// What a team loop can take for granted about the loop before it: that it
+/// ended with a barrier (or there was none), that it ended without one, or
+/// that it recorded the progress of its blocks.
+///
+enum class team_after { barrier, loop, blocks };
+
+///
+/// The team a thread runs lws team loops for, the OpenMP nesting level of
+/// the team's region, and how many loops the thread has started; then how
+/// the thread's previous loop ended, and for each context the block counts
+/// that the dependent loops of the thread so far add up to.
+///
+struct team_thread {
+  team* current = nullptr;
+  int level = 0;
+  long loops = 0;
+  team_after after = team_after::barrier;
+  int prevContext = 0;
+  int prevLength = 0;
+  long expected[team_contexts][team_blocks] = {};
+};
+
+inline team_thread& this_team_thread()
+{
+  static thread_local team_thread self{};
+  return self;
+}
+
+///
+/// The team of the calling thread, or nullptr if it is not running directly
+/// in an omp_lws_region (it may be in a parallel region nested in one).
+///
+inline team_thread* current_team_thread()
+{
+  team_thread& self = this_team_thread();
+  if (self.current == nullptr || self.level != omp_get_level()) {
+    return nullptr;
+  }
+  return &self;
+}
+
+///
+/// Acquires the contexts of a team of up to numThreads threads; returns
+/// false, with nothing acquired, if the pool and the heap are exhausted.
+///
+inline bool team_acquire(team& t, int numThreads)
+{
+  t.trace = trace_new_loop();
+  for (int c = 0; c < team_contexts; ++c) {
+    t.ctx[c] = vSched_context_acquire(numThreads);
+    t.done[c].threads.store(0, std::memory_order_relaxed);
+    for (int b = 0; b < team_blocks; ++b) {
+      t.blocks[c][b].iterations.store(0, std::memory_order_relaxed);
+    }
+    if (t.ctx[c] == nullptr) {
+      for (int r = 0; r < c; ++r) {
+        vSched_context_release(t.ctx[r]);
+      }
+      return false;
+    }
+  }
+  return true;
+}
+
+inline void team_release(team& t)
+{
+  for (int c = 0; c < team_contexts; ++c) {
+    vSched_context_release(t.ctx[c]);
+  }
+}
+
+///
+/// The context for the next loop of the calling thread. The context was last
+/// used team_contexts loops ago; the thread waits until every thread of the
+/// team is done with that loop, which it only has to do if it got that far
+/// ahead of the slowest thread.
+///
+inline vSched_context* team_loop_begin(team_thread& self, int* context)
+{
+  const long loop = self.loops++;
+  const int c = static_cast<int>(loop % team_contexts);
+  const long finished = (loop / team_contexts) * omp_get_num_threads();
+  team& t = *self.current;
+  while (t.done[c].threads.load(std::memory_order_acquire) < finished) {
+    std::this_thread::yield();
+  }
+  trace_next_loop(trace_loop{t.trace.id, static_cast<int>(self.loops)});
+  *context = c;
+  return t.ctx[c];
+}
+
+inline void team_loop_end(team_thread& self,
+                          int context,
+                          team_after after = team_after::loop,
+                          int length = 0)
+{
+  self.current->done[context].threads.fetch_add(1, std::memory_order_release);
+  self.after = after;
+  self.prevContext = context;
+  self.prevLength = length;
+}
+
+///
+/// The handle of the calling thread's last team loop.
+///
+inline loop_handle team_last_loop(const team_thread& self)
+{
+  const long loop = self.loops - 1;
+  return loop_handle(
+      &self.current->done[loop % team_contexts].threads,
+      (loop / team_contexts + 1) * omp_get_num_threads());
+}
+
+///
+/// Waits until every thread of the team finished the calling thread's last
+/// team loop, unless the loop ended with a barrier. A dependent loop passes
+/// byBlocks, and only waits here if the last loop did not record its blocks.
+///
+inline void team_wait_last_loop(const team_thread& self, bool byBlocks = false)
+{
+  if (self.after == team_after::loop
+      || (self.after == team_after::blocks && !byBlocks)) {
+    team_last_loop(self).wait();
+  }
+}
+
+///
+/// Block b of a loop of n iterations is
+/// [team_block_begin(n, b), team_block_begin(n, b + 1)).
+///
+inline int team_block_begin(int n, int b)
+{
+  return static_cast<int>((static_cast<long long>(n) * b) / team_blocks);
+}
+
+inline int team_block_of(int n, int i)
+{
+  return static_cast<int>(
+      ((static_cast<long long>(i) + 1) * team_blocks - 1) / n);
+}
+
+///
+/// The calling thread's side of a dependent team loop of n iterations on
+/// context. The chunks of a thread's own queue follow each other, so it
+/// does not check again the blocks of the previous loop it has seen
+/// finished, and it records the iterations it finishes in a block together,
+/// when it moves on to another block or ends the loop.
+///
+class team_depend_loop
+{
+public:
+  team_depend_loop(team_thread& self, int context, int n)
+      : m_self(self), m_context(context), m_n(n)
+  {
+  }
+
+  ///
+  /// Waits until the iterations [begin, end) of the calling thread's last
+  /// team loop are finished, if that loop recorded its blocks.
+  ///
+  void wait_for(long begin, long end)
+  {
+    const int n = m_self.prevLength;
+    const int first = static_cast<int>(std::max(begin, 0L));
+    const int last = static_cast<int>(std::min(end, static_cast<long>(n)));
+    if (m_self.after != team_after::blocks || first >= last) {
+      return;
+    }
+    const int c = m_self.prevContext;
+    const int firstBlock = team_block_of(n, first);
+    const int lastBlock = team_block_of(n, last - 1);
+    for (int b = firstBlock; b <= lastBlock; ++b) {
+      if (b >= m_readyFirst && b <= m_readyLast) {
+        continue;
+      }
+      while (m_self.current->blocks[c][b].iterations.load(
+                 std::memory_order_acquire)
+             < m_self.expected[c][b]) {
+        std::this_thread::yield();
+      }
+    }
+    if (firstBlock <= m_readyLast + 1 && lastBlock >= m_readyFirst - 1) {
+      m_readyFirst = std::min(m_readyFirst, firstBlock);
+      m_readyLast = std::max(m_readyLast, lastBlock);
+    } else {
+      m_readyFirst = firstBlock;
+      m_readyLast = lastBlock;
+    }
+  }
+
+  /// the iterations [begin, end) of the loop are finished
+  void finished(int begin, int end)
+  {
+    for (int b = team_block_of(m_n, begin); begin < end; ++b) {
+      const int blockEnd = std::min(end, team_block_begin(m_n, b + 1));
+      if (b != m_block) {
+        flush();
+        m_block = b;
+      }
+      m_pending += blockEnd - begin;
+      begin = blockEnd;
+    }
+  }
+
+  ///
+  /// Ends the loop for the calling thread: the blocks of the loop are
+  /// finished once their counts reach the new expected counts.
+  ///
+  void end()
+  {
+    flush();
+    for (int b = 0; b < team_blocks; ++b) {
+      m_self.expected[m_context][b] +=
+          team_block_begin(m_n, b + 1) - team_block_begin(m_n, b);
+    }
+    team_loop_end(m_self, m_context, team_after::blocks, m_n);
+  }
+
+private:
+  void flush()
+  {
+    if (m_pending != 0) {
+      m_self.current->blocks[m_context][m_block].iterations.fetch_add(
+          m_pending, std::memory_order_release);
+      m_pending = 0;
+    }
+  }
+
+  team_thread& m_self;
+  int m_context;
+  int m_n;
+  // blocks of the previous loop seen finished
+  int m_readyFirst = 0;
+  int m_readyLast = -1;
+  // iterations finished in block m_block and not recorded yet
+  int m_block = 0;
+  long m_pending = 0;
+};
+
+}  // closing brace for detail namespace
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for if defined(RAJA_ENABLE_OPENMP)
+
+#endif  // closing endif for header file include guard
@@ -0,0 +1,383 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file for the timeline of the chunks that lws and OpenMP
+ *          loops ran, written as a Chrome trace (chrome://tracing, Perfetto).
+ *
+ *          Chunks are only recorded when RAJA is configured with
+ *          ENABLE_LWS_TRACE; otherwise the recording compiles to nothing
+ *          and the trace is empty.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_trace_openmp_HPP
+#define RAJA_lws_trace_openmp_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP) || defined(RAJA_ENABLE_LWS_THREADS)
+
+#include <atomic>
+#include <iosfwd>
+#include <vector>
+
+#include "RAJA/util/macros.hpp"
+
+#include "RAJA/policy/openmp/vSched_internal.h"
+
+namespace RAJA
+{
+namespace lws
+{
+
+#if defined(RAJA_ENABLE_LWS_TRACE)
+constexpr bool trace_enabled = true;
+#else
+constexpr bool trace_enabled = false;
+#endif
+
+///
+/// Events each thread can record until the trace is cleared; later chunks
+/// are counted as dropped, so the memory and the cost of tracing stay
+/// bounded however long the program runs.
+///
+constexpr long trace_capacity = 1L << 16;
+
+/*!
+ * \brief One chunk of a traced loop.
+ *
+ * Loops are numbered in the order they started, from 1. The loops of an
+ * omp_lws_region, and the loops in a RAJA::region that no parallel forall
+ * policy started, share the number of the region and are told apart by
+ * step, which counts them from 1; step is 0 for the other loops. Loop 0 is
+ * a loop run by lws_for_thread outside of the forall policies, or a loop in
+ * a parallel region that RAJA did not start, which can't be numbered
+ * without synchronizing its threads.
+ */
+struct trace_event {
+  long loop;
+  int step;
+  int thread;       // thread number in the loop
+  int begin;        // iterations [begin, end) of the loop
+  int end;
+  int stolen_from;  // thread the chunk was stolen from, -1 if it wasn't
+  double start;     // seconds, from vSched_now()
+  double stop;
+};
+
+/*!
+ * \brief Turns recording on or off at run time; it is on from the start.
+ *        Only change it between loops.
+ */
+void set_tracing(bool on);
+
+bool tracing();
+
+/*!
+ * \brief The events recorded since the last clear_trace(), thread by thread
+ *        and in the order each thread recorded them. Call it between loops.
+ */
+std::vector<trace_event> get_trace();
+
+/*!
+ * \brief Chunks that did not fit in the buffers since the last clear_trace().
+ */
+long trace_dropped();
+
+void clear_trace();
+
+/*!
+ * \brief Writes the events as Chrome trace JSON, one complete ("X") event
+ *        per chunk, with a track per OS thread and times in microseconds
+ *        from the first event.
+ */
+void write_trace(std::ostream& out);
+
+/*!
+ * \brief Writes the trace to the file at path; returns false if the file
+ *        can't be written.
+ */
+bool write_trace(const char* path);
+
+namespace detail
+{
+
+///
+/// The loop a traced chunk belongs to.
+///
+struct trace_loop {
+  long id;
+  int step;
+};
+
+///
+/// Buffer of the calling thread, registered the first time it records.
+/// Only its thread appends to it, so recording takes no lock: the event is
+/// written, then published by storing the new size.
+///
+struct trace_buffer {
+  trace_event* events;
+  std::atomic<long> size;
+  long dropped;
+  int track;  // Chrome trace tid
+  trace_buffer* next;
+
+  RAJA_INLINE void append(const trace_event& e)
+  {
+    const long n = size.load(std::memory_order_relaxed);
+    if (n < trace_capacity) {
+      events[n] = e;
+      size.store(n + 1, std::memory_order_release);
+    } else {
+      ++dropped;
+    }
+  }
+};
+
+#if defined(RAJA_ENABLE_LWS_TRACE)
+
+trace_buffer* trace_thread_buffer();
+
+trace_loop trace_new_loop();
+
+///
+/// Sets the loop the next chunks run by the calling thread belong to; the
+/// tracer of that loop takes it, so a loop nested in its body gets its own.
+///
+void trace_next_loop(trace_loop loop);
+
+trace_loop trace_take_loop();
+
+///
+/// The RAJA::region the calling thread runs in: its number, claimed by the
+/// first of its threads to need it, and how many of its loops the thread
+/// has traced, so its threads number the loops alike without a barrier.
+///
+struct trace_region {
+  std::atomic<long>* id = nullptr;  // 0 until claimed, -1 while it is
+  int level = 0;
+  int steps = 0;
+};
+
+inline trace_region& this_trace_region()
+{
+  static thread_local trace_region self{};
+  return self;
+}
+
+///
+/// Makes the calling thread's loops traced as steps of the region whose
+/// number id will hold, until the scope ends; level is the OpenMP level of
+/// the region.
+///
+class trace_region_scope
+{
+public:
+  trace_region_scope(std::atomic<long>& id, int level)
+      : m_outer(this_trace_region())
+  {
+    trace_region& self = this_trace_region();
+    self = trace_region{};
+    self.id = &id;
+    self.level = level;
+  }
+
+  ~trace_region_scope() { this_trace_region() = m_outer; }
+
+private:
+  trace_region m_outer;
+};
+
+///
+/// The next loop of the region the calling thread runs in at OpenMP level
+/// level, or loop 0 if it does not run in a RAJA::region there.
+///
+inline trace_loop trace_region_next_loop(int level)
+{
+  trace_region& self = this_trace_region();
+  if (self.id == nullptr || self.level != level) {
+    return trace_loop{0, 0};
+  }
+  long id = self.id->load(std::memory_order_acquire);
+  while (id <= 0) {
+    long unclaimed = 0;
+    if (id == 0 && self.id->compare_exchange_strong(unclaimed, -1)) {
+      id = trace_new_loop().id;
+      self.id->store(id, std::memory_order_release);
+    } else {
+      id = self.id->load(std::memory_order_acquire);
+    }
+  }
+  return trace_loop{id, ++self.steps};
+}
+
+///
+/// Records the chunks that one thread runs in one lws loop, with the time
+/// around the body and whether the chunk was stolen.
+///
+class chunk_tracer
+{
+public:
+  explicit chunk_tracer(int thread)
+      : m_buffer(tracing() ? trace_thread_buffer() : nullptr),
+        m_loop(trace_take_loop()),
+        m_thread(thread)
+  {
+    // forget a steal recorded while tracing was off
+    vSched_take_stolen_from();
+  }
+
+  void start(int begin, int end)
+  {
+    if (m_buffer != nullptr && begin < end) {
+      m_begin = begin;
+      m_end = end;
+      m_stolen = vSched_take_stolen_from();
+      m_start = vSched_now();
+    }
+  }
+
+  void stop()
+  {
+    if (m_buffer != nullptr && m_begin < m_end) {
+      m_buffer->append(trace_event{m_loop.id,
+                                   m_loop.step,
+                                   m_thread,
+                                   m_begin,
+                                   m_end,
+                                   m_stolen,
+                                   m_start,
+                                   vSched_now()});
+      m_end = m_begin;
+    }
+  }
+
+private:
+  trace_buffer* m_buffer;
+  trace_loop m_loop;
+  int m_thread;
+  int m_begin = 0;
+  int m_end = 0;
+  int m_stolen = -1;
+  double m_start = 0.0;
+};
+
+///
+/// Records the chunks of an OpenMP worksharing loop, which only shows the
+/// iterations: a chunk starts at an iteration that does not follow the last
+/// one, and ends when the next one starts or the loop ends.
+///
+class iteration_tracer
+{
+public:
+  iteration_tracer(trace_loop loop, int thread)
+      : m_buffer(tracing() ? trace_thread_buffer() : nullptr),
+        m_loop(loop),
+        m_thread(thread)
+  {
+  }
+
+  ~iteration_tracer() { end(); }
+
+  RAJA_INLINE void visit(long i)
+  {
+    // loop invariant, so the compiler can keep a loop without the tracing
+    if (m_buffer == nullptr) {
+      return;
+    }
+    if (i != m_next) {
+      end();
+      m_begin = i;
+      m_start = vSched_now();
+    }
+    m_next = i + 1;
+  }
+
+  void end()
+  {
+    if (m_buffer != nullptr && m_begin < m_next) {
+      m_buffer->append(trace_event{m_loop.id,
+                                   m_loop.step,
+                                   m_thread,
+                                   static_cast<int>(m_begin),
+                                   static_cast<int>(m_next),
+                                   -1,
+                                   m_start,
+                                   vSched_now()});
+    }
+    m_begin = m_next;
+  }
+
+private:
+  trace_buffer* m_buffer;
+  trace_loop m_loop;
+  int m_thread;
+  long m_begin = -1;
+  long m_next = -1;
+  double m_start = 0.0;
+};
+
+#else
+
+inline trace_loop trace_new_loop() { return trace_loop{0, 0}; }
+
+inline void trace_next_loop(trace_loop) {}
+
+inline trace_loop trace_take_loop() { return trace_loop{0, 0}; }
+
+class trace_region_scope
+{
+public:
+  trace_region_scope(std::atomic<long>&, int) {}
+};
+
+inline trace_loop trace_region_next_loop(int) { return trace_loop{0, 0}; }
+
+class chunk_tracer
+{
+public:
+  explicit chunk_tracer(int) {}
+
+  void start(int, int) {}
+
+  void stop() {}
+};
+
+class iteration_tracer
+{
+public:
+  iteration_tracer(trace_loop, int) {}
+
+  void visit(long) {}
+
+  void end() {}
+};
+
+#endif
+
+}  // closing brace for detail namespace
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for RAJA_ENABLE_OPENMP or RAJA_ENABLE_LWS_THREADS
+
+#endif  // closing endif for header file include guard
@@ -0,0 +1,132 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Header file for the online tuning of the lws schedule parameters
+ *          used by the omp_lws_tuned policy.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#ifndef RAJA_lws_tuning_openmp_HPP
+#define RAJA_lws_tuning_openmp_HPP
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP)
+
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+namespace RAJA
+{
+namespace lws
+{
+
+/*!
+ * \brief A call site of an omp_lws_tuned loop: the type of the loop body
+ *        and the number of iterations.
+ *
+ * Every lambda has its own type, so a lambda in a timestep loop is one
+ * call site for each range size it is run with.
+ */
+struct tuning_key {
+  std::type_index body;
+  long range_size;
+
+  bool operator<(const tuning_key& other) const
+  {
+    return body < other.body
+           || (body == other.body && range_size < other.range_size);
+  }
+};
+
+/*!
+ * \brief Schedule parameters learned (or pinned) for one call site.
+ */
+struct tuned_parameters {
+  float static_fraction;
+  int chunk_size;
+  int invocations;  // loops run at the call site
+  bool converged;   // the parameters are no longer changed
+  bool pinned;      // the parameters were set with pin_tuning()
+};
+
+template <typename Func>
+tuning_key make_tuning_key(const Func&, long range_size)
+{
+  return tuning_key{std::type_index(typeid(Func)), range_size};
+}
+
+/*!
+ * \brief Returns the parameters of a call site, or the initial parameters
+ *        if the call site has not run yet.
+ */
+tuned_parameters get_tuning(const tuning_key& key);
+
+/*!
+ * \brief Returns the parameters of every call site seen so far.
+ */
+std::vector<std::pair<tuning_key, tuned_parameters>> get_all_tuning();
+
+/*!
+ * \brief Fixes the parameters of a call site, which then stops tuning.
+ *        Can be called before the call site first runs.
+ */
+void pin_tuning(const tuning_key& key, float static_fraction, int chunk_size);
+
+/*!
+ * \brief Lets a pinned call site tune again, starting from its pinned
+ *        parameters.
+ */
+void unpin_tuning(const tuning_key& key);
+
+/*!
+ * \brief Forgets every call site, pinned or not.
+ */
+void reset_tuning();
+
+namespace detail
+{
+
+/*!
+ * \brief What one run of a tuned loop measured.
+ */
+struct tuning_sample {
+  double skew;   // spread of the thread finish times, relative to the loop time
+  int steals;    // successful steals by all threads
+  int num_threads;
+};
+
+/// parameters to run the next loop of a call site with
+tuned_parameters tuning_begin(const tuning_key& key);
+
+/// adjusts the parameters of a call site from one run with them
+void tuning_end(const tuning_key& key, const tuning_sample& sample);
+
+}  // closing brace for detail namespace
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for if defined(RAJA_ENABLE_OPENMP)
+
+#endif  // closing endif for header file include guard
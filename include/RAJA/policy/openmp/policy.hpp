@@ -29,9 +29,12 @@
 #include <type_traits>
 
 #include "RAJA/policy/PolicyBase.hpp"
+#include "RAJA/policy/lws/costs.hpp"
+#include "RAJA/policy/lws/strategy.hpp"
 
 namespace RAJA
 {
+
 namespace policy
 {
 
@@ -50,6 +53,9 @@ struct For {
 struct NoWait {
 };
 
+struct Lws {
+};
+
 template <unsigned int ChunkSize>
 struct Static : std::integral_constant<unsigned int, ChunkSize> {
 };
@@ -96,6 +102,40 @@ struct omp_for_nowait_exec
                                             omp::NoWait> {
 };
 
+///
+/// Lightweight scheduling (lws) of the iterations of a loop: a static
+/// fraction of each thread's share is run without synchronization and the
+/// rest is handed out in chunks from per-thread queues that idle threads
+/// steal from (see vSched.c).
+///
+struct omp_lws_for_exec
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::For,
+                                            omp::Lws> {
+};
+
+///
+/// lws scheduling with the strategy, static fraction (in percent of the
+/// iterations) and chunk size fixed at compile time.
+///
+template <typename Strategy = lws::statdynstaggered,
+          int StaticFractionPercent = 50,
+          int ChunkSize = 16>
+struct omp_for_lws
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::For,
+                                            omp::Lws> {
+  static_assert(StaticFractionPercent >= 0 && StaticFractionPercent <= 100,
+                "lws static fraction must be a percentage");
+  static_assert(ChunkSize > 0, "lws chunk size must be positive");
+};
+
 template <unsigned int N>
 struct omp_for_static : make_policy_pattern_launch_platform_t<Policy::openmp,
                                                               Pattern::forall,
@@ -119,13 +159,147 @@ struct omp_parallel_exec
 struct omp_parallel_for_exec : omp_parallel_exec<omp_for_exec> {
 };
 
-struct omp_lws: omp_parallel_exec<omp_lws> {
+struct omp_lws : omp_parallel_exec<omp_lws_for_exec> {
 };
-    
+
 template <unsigned int N>
 struct omp_parallel_for_static : omp_parallel_exec<omp_for_static<N>> {
 };
 
+///
+/// lws scheduling (statdynstaggered) in its own parallel region, with the
+/// static fraction and chunk size tuned online for each call site, see
+/// lws_tuning.hpp.
+///
+struct omp_lws_tuned
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::Parallel,
+                                            omp::Lws> {
+};
+
+///
+/// lws scheduling (statdynstaggered) in its own parallel region that keeps
+/// the iterations on the threads that ran them in the previous run of the
+/// same call site, for cache locality across the timesteps of an iterative
+/// solver. The recorded assignment is replayed as the static part of a run:
+/// a thread's largest recorded range is split by the static fraction like
+/// its share of a statdynstaggered loop, and idle threads steal from the
+/// dynamic rest of it. When a replay's finish-time spread still exceeds
+/// ImbalanceThresholdPercent of its duration, the next run schedules
+/// dynamically and records again.
+///
+template <int ImbalanceThresholdPercent = 10>
+struct omp_lws_sticky
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::Parallel,
+                                            omp::Lws> {
+  static_assert(ImbalanceThresholdPercent >= 0,
+                "lws imbalance threshold must not be negative");
+};
+
+///
+/// lws scheduling (statdynstaggered) in its own parallel region that splits
+/// the loop by the cost of its iterations instead of by their number: the
+/// static part of every thread and every dynamic chunk cover the same cost.
+/// The policy is passed by value, e.g.
+///
+///   forall(omp_lws_weighted<int>(lws::cost_prefix(row_offsets)), ...)
+///
+template <typename T>
+struct omp_lws_weighted
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::Parallel,
+                                            omp::Lws> {
+  explicit omp_lws_weighted(lws::cost_view<T> costs_) : costs(costs_) {}
+
+  lws::cost_view<T> costs;
+};
+
+///
+/// A parallel region for a sequence of lws loops. The team acquires its
+/// scheduler contexts once, and the omp_lws_team_exec and
+/// omp_lws_team_nowait_exec loops in the region reuse them, so a loop costs
+/// no fork/join and no scheduler setup. Every thread of the team must run
+/// the same sequence of team loops, as for OpenMP worksharing loops.
+///
+struct omp_lws_region
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::region,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::Lws> {
+};
+
+///
+/// lws loop of an omp_lws_region team, followed by a barrier. After a team
+/// loop without a barrier it first waits for the whole loop. Outside an
+/// omp_lws_region it runs like omp_lws_for_exec.
+///
+struct omp_lws_team_exec
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::For,
+                                            omp::Lws> {
+};
+
+///
+/// lws loop of an omp_lws_region team without a barrier. A thread that
+/// finishes goes on with the code after the loop while the others are still
+/// running it, so that code must not read what the loop writes, or must
+/// first wait on the handle RAJA::lws::forall_async returns for the loop.
+/// The next team loop waits for the whole loop before it starts.
+///
+struct omp_lws_team_nowait_exec
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::For,
+                                            omp::NoWait,
+                                            omp::Lws> {
+};
+
+///
+/// lws loop of an omp_lws_region team without a barrier, whose iteration i
+/// only depends on the iterations i - Halo to i + Halo of the team loop
+/// before it (by position in the segments): it reads what they write, or
+/// writes what they read. A chunk waits for those iterations alone, so
+/// threads that finish the previous loop early start on this one instead of
+/// waiting for the slowest thread. After an omp_lws_team_nowait_exec loop it
+/// waits for the whole loop, and a team loop after it without a halo waits
+/// for the whole of it. Outside an omp_lws_region it runs like
+/// omp_lws_for_exec.
+///
+template <int Halo = 0>
+struct omp_lws_team_depend_exec
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::For,
+                                            omp::NoWait,
+                                            omp::Lws> {
+  static_assert(Halo >= 0, "lws dependency halo must not be negative");
+};
+
+template <typename Strategy = lws::statdynstaggered,
+          int StaticFractionPercent = 50,
+          int ChunkSize = 16>
+struct omp_parallel_for_lws
+    : omp_parallel_exec<omp_for_lws<Strategy, StaticFractionPercent, ChunkSize>> {
+};
+
 ///
 /// Policies for applying OpenMP clauses in forallN loop nests.
 ///
@@ -163,6 +337,24 @@ using omp_parallel_for_segit = omp_parallel_for_exec;
 
 using omp_parallel_segit = omp_parallel_for_segit;
 
+///
+/// lws scheduling (statdynstaggered) of the iterations of all segments of an
+/// index set in one parallel region. The static part of each thread's share
+/// and the stolen chunks are measured in iterations, so segments are weighed
+/// by their length, and a chunk may run part of a RangeSegment; segments of
+/// other types are run whole by the thread whose chunk holds their first
+/// iteration. Each segment keeps its own execution policy for the iterations
+/// it runs.
+///
+struct omp_lws_segit
+    : make_policy_pattern_launch_platform_t<Policy::openmp,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host,
+                                            omp::Parallel,
+                                            omp::Lws> {
+};
+
 struct omp_taskgraph_segit
     : make_policy_pattern_t<Policy::openmp, Pattern::taskgraph, omp::Parallel> {
 };
@@ -193,6 +385,16 @@ struct omp_reduce_ordered
     : make_policy_pattern_t<Policy::openmp, Pattern::reduce, reduce::ordered> {
 };
 
+///
+/// Gives the same result, to the bit, for any thread count and schedule,
+/// omp_lws stealing included: floating-point sums are exact until get().
+///
+struct omp_reduce_reproducible
+    : make_policy_pattern_t<Policy::openmp,
+                            Pattern::reduce,
+                            reduce::reproducible> {
+};
+
 struct omp_synchronize : make_policy_pattern_launch_t<Policy::openmp,
                                                       Pattern::synchronize,
                                                       Launch::sync> {
@@ -203,16 +405,29 @@ struct omp_synchronize : make_policy_pattern_launch_t<Policy::openmp,
 
 using policy::omp::omp_for_exec;
 using policy::omp::omp_lws;
+using policy::omp::omp_lws_tuned;
+using policy::omp::omp_lws_sticky;
+using policy::omp::omp_lws_weighted;
+using policy::omp::omp_lws_for_exec;
+using policy::omp::omp_lws_region;
+using policy::omp::omp_lws_team_exec;
+using policy::omp::omp_lws_team_nowait_exec;
+using policy::omp::omp_lws_team_depend_exec;
+using policy::omp::omp_for_lws;
+using policy::omp::omp_parallel_for_lws;
 using policy::omp::omp_for_nowait_exec;
 using policy::omp::omp_for_static;
 using policy::omp::omp_parallel_exec;
 using policy::omp::omp_parallel_region;
 using policy::omp::omp_parallel_for_exec;
+using policy::omp::omp_parallel_for_static;
 using policy::omp::omp_parallel_segit;
 using policy::omp::omp_parallel_for_segit;
+using policy::omp::omp_lws_segit;
 using policy::omp::omp_collapse_nowait_exec;
 using policy::omp::omp_reduce;
 using policy::omp::omp_reduce_ordered;
+using policy::omp::omp_reduce_reproducible;
 using policy::omp::omp_synchronize;
 
 #if defined(RAJA_ENABLE_TARGET_OPENMP)
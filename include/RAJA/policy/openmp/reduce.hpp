@@ -41,6 +41,9 @@
 #include "RAJA/util/types.hpp"
 
 #include "RAJA/pattern/detail/reduce.hpp"
+#include "RAJA/pattern/detail/reduce_array.hpp"
+#include "RAJA/pattern/detail/reduce_slots.hpp"
+#include "RAJA/pattern/detail/reproducible.hpp"
 #include "RAJA/pattern/reduce.hpp"
 
 #include "RAJA/policy/openmp/policy.hpp"
@@ -51,30 +54,59 @@ namespace RAJA
 
 namespace detail
 {
+
 template <typename T, typename Reduce>
 class ReduceOMP
     : public reduce::detail::BaseCombinable<T, Reduce, ReduceOMP<T, Reduce>>
 {
   using Base = reduce::detail::BaseCombinable<T, Reduce, ReduceOMP>;
+  // only the reducer the copies are made from has slots, one per thread
+  std::unique_ptr<reduce::detail::ReduceSlots<T>> slots;
 
 public:
-  using Base::Base;
   //! prohibit compiler-generated default ctor
   ReduceOMP() = delete;
 
+  ReduceOMP(T init_val, T identity_ = T())
+      : Base(init_val, identity_),
+        slots(new reduce::detail::ReduceSlots<T>(omp_get_max_threads(),
+                                                  identity_))
+  {
+  }
+
+  ReduceOMP(const ReduceOMP& other) : Base(other) {}
+
+  void reset(T init_val, T identity_)
+  {
+    Base::reset(init_val, identity_);
+    if (slots) {
+      slots->reset(identity_);
+    }
+  }
+
   ~ReduceOMP()
   {
     if (Base::parent) {
-#pragma omp critical(ompReduceCritical)
-      Reduce()(Base::parent->local(), Base::my_data);
+      static_cast<const ReduceOMP*>(Base::parent)
+          ->slots->template combine<Reduce>(omp_get_thread_num(),
+                                            Base::my_data);
       Base::my_data = Base::identity;
     }
   }
+
+  T get_combined() const
+  {
+    if (slots) {
+      slots->template collect<Reduce>(Base::my_data, Base::identity);
+    }
+    return Base::my_data;
+  }
 };
 
 } /* detail */
 
 RAJA_DECLARE_ALL_REDUCERS(omp_reduce, detail::ReduceOMP)
+RAJA_DECLARE_ARRAY_REDUCER(omp_reduce, reduce::detail::ReduceArrayPrivate)
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -133,6 +165,85 @@ public:
 
 RAJA_DECLARE_ALL_REDUCERS(omp_reduce_ordered, detail::ReduceOMPOrdered)
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// Reproducible reductions.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace detail
+{
+///
+/// Accumulates into a reduce::detail::reproducible accumulator, in the same
+/// per-thread slots as ReduceOMP; which thread adds which value doesn't
+/// change the result.
+///
+template <typename T, typename Reduce>
+class ReduceOMPReproducible
+{
+  using traits = reduce::detail::reproducible<T, Reduce>;
+  using acc_type = typename traits::acc_type;
+  using merge = typename traits::merge;
+
+  const ReduceOMPReproducible* parent = nullptr;
+  T identity;
+  acc_type mutable my_acc;
+  // only the reducer the copies are made from has slots, one per thread
+  std::unique_ptr<reduce::detail::ReduceSlots<acc_type>> slots;
+
+public:
+  //! prohibit compiler-generated default ctor
+  ReduceOMPReproducible() = delete;
+
+  ReduceOMPReproducible(T init_val, T identity_ = T())
+      : identity(identity_),
+        my_acc(traits::make(identity_)),
+        slots(new reduce::detail::ReduceSlots<acc_type>(omp_get_max_threads(),
+                                                        my_acc))
+  {
+    traits::add(my_acc, init_val);
+  }
+
+  ReduceOMPReproducible(const ReduceOMPReproducible& other)
+      : parent(other.parent ? other.parent : &other),
+        identity(other.identity),
+        my_acc(traits::make(other.identity))
+  {
+  }
+
+  ~ReduceOMPReproducible()
+  {
+    if (parent) {
+      parent->slots->template combine<merge>(omp_get_thread_num(), my_acc);
+    }
+  }
+
+  void reset(T init_val, T identity_)
+  {
+    identity = identity_;
+    my_acc = traits::make(identity_);
+    if (slots) {
+      slots->reset(my_acc);
+    }
+    traits::add(my_acc, init_val);
+  }
+
+  void combine(const T& value) { traits::add(my_acc, value); }
+
+  T get() const
+  {
+    if (slots) {
+      slots->template collect<merge>(my_acc, traits::make(identity));
+    }
+    return traits::result(my_acc);
+  }
+};
+
+} /* detail */
+
+RAJA_DECLARE_ALL_REDUCERS(omp_reduce_reproducible,
+                          detail::ReduceOMPReproducible)
+
 }  // closing brace for RAJA namespace
 
 #endif  // closing endif for RAJA_ENABLE_OPENMP guard
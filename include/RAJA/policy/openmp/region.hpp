@@ -16,6 +16,11 @@
 #ifndef RAJA_region_openmp_HPP
 #define RAJA_region_openmp_HPP
 
+#include <atomic>
+
+#include "RAJA/policy/openmp/lws_team.hpp"
+#include "RAJA/policy/openmp/policy.hpp"
+
 namespace RAJA
 {
 namespace policy
@@ -45,9 +50,57 @@ namespace omp
 template <typename Func>
 RAJA_INLINE void region_impl(const omp_parallel_region &, Func &&body)
 {
+  std::atomic<long> trace_id{0};
+
+#pragma omp parallel
+  {
+    lws::detail::trace_region_scope trace(trace_id, omp_get_level());
+    body();
+  }
+}
+
+/*!
+ * \brief RAJA::region implementation for a team that runs a sequence of lws
+ *        loops.
+ *
+ * \code
+ *
+ * RAJA::region<omp_lws_region>([=](){
+ *
+ *  RAJA::forall<omp_lws_team_exec>(range, first);
+ *  RAJA::forall<omp_lws_team_nowait_exec>(range, second);
+ *  thread_private_work();  // overlaps the threads still in second
+ *  RAJA::forall<omp_lws_team_exec>(range, after_all_of_second);
+ *  RAJA::forall<omp_lws_team_depend_exec<1>>(range, reads_neighbors_of_prev);
+ *
+ *  });
+ *
+ * \endcode
+ */
+template <typename Func>
+RAJA_INLINE void region_impl(const omp_lws_region &, Func &&body)
+{
+  lws::detail::team team;
+  if (!lws::detail::team_acquire(team, omp_get_max_threads())) {
+    // the team loops run as omp_lws_for_exec loops
+    region_impl(omp_parallel_region{}, body);
+    return;
+  }
 
+  std::atomic<long> trace_id{0};
 #pragma omp parallel
-  body();
+  {
+    lws::detail::team_thread &self = lws::detail::this_team_thread();
+    const lws::detail::team_thread outer = self;
+    self = lws::detail::team_thread{};
+    self.current = &team;
+    self.level = omp_get_level();
+    lws::detail::trace_region_scope trace(trace_id, omp_get_level());
+    body();
+    self = outer;
+  }
+
+  lws::detail::team_release(team);
 }
 
 }  // closing brace for omp namespace
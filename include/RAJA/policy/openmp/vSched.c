@@ -1,346 +1,1230 @@
-// This code file comes from the git repository github.com/vlkale/lw-sched. The file is located at : 
+// This code file comes from the git repository github.com/vlkale/lw-sched. The file is located at :
 //
 // github.com/vlkale/lw-sched/vSched.c
-// 
+//
 // Update this file with the file from the repository to get the latest version having new loop scheduling strategies and further enhancements. This code is well-tested and self-contained.
 
-// TODO: ought to have a way to link the code file vSched.c from that repository here in this repository. 
+// TODO: ought to have a way to link the code file vSched.c from that repository here in this repository.
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE // for sched_getcpu()
+#endif
 #include <pthread.h> // can use other threaded runtime library like ECP's BOLT. The library needs to be generalized to handle different libraries
 //flag used for debugging output
 //#define VERBOSE
 
-#define PROFILING
-
 #include <stdio.h> // use this for testing
-pthread_mutex_t sched_lock;
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+#include <unistd.h>
 
-#include <sys/time.h>
-#include <sys/resource.h>
-// could declare below as static
-float f_s;
-float f_d;
-float constraint_;
-int chunkSize;
-int nextChunk;
-int loopEnd;
-int isLoopStarted;
+#include "vSched_internal.h"
 
-int count ;
-int threadCount;
+static pthread_mutex_t init_lock = PTHREAD_MUTEX_INITIALIZER;
 
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
 
+// number of contexts that are reused across loops before vSched_context_acquire() falls back to malloc
+#define VSCHED_POOL_SIZE 16
 
-// functions internal to the vSched library
-int get_constraint();
-double vSched_get_wtime();
+/*
+  The context used by the loop_start_*()/loop_next_*() functions that don't
+  take one, and whose parameters are the defaults for acquired contexts.
+  f_s and chunkSize are used until setStaticFraction() or setCDY() is called,
+  and the cdy constraint lets every dequeue through until setCDY(). The
+  fields that are not named start at 0.
+*/
+static vSched_context defaultContext = {
+  .f_s = 0.5,
+  .f_d = 0.5,
+  .constraint_ = 1.0,
+  .chunkSize = 16,
+  .victimSelection = VSCHED_VICTIM_RANDOM,
+  .stealHalf = 0,
+  .crossSocketThreshold = 4,
+  .dynwork = NULL,
+  .sched_lock = PTHREAD_MUTEX_INITIALIZER,
+  .inUse = 1,
+  .pooled = 0,
+  .cdyConstraint = NULL,
+  .cdyConstraintArg = NULL
+};
 
-typedef struct PossibleWork  // coem up with a better name
+static vSched_context contextPool[VSCHED_POOL_SIZE];
+static pthread_once_t contextPoolOnce = PTHREAD_ONCE_INIT;
+
+#if defined(RAJA_ENABLE_LWS_STATS)
+/*
+  The statistics of one thread, in a cache line of their own. A slot is
+  linked into statsSlots the first time its thread records something, and
+  is kept after the thread exits so its counts are still reported.
+*/
+typedef struct vSched_stats_slot
 {
-  int nextChunk;
-  int chunkSize;
-  int limit; //this is the iteration that we should not assign.
-  pthread_mutex_t qLock;
-} PossibleWork ;
+  vSched_stats stats;
+  struct vSched_stats_slot* next;
+} vSched_stats_slot;
+
+static vSched_stats_slot* statsSlots = NULL;
+static __thread vSched_stats_slot* myStatsSlot = NULL;
+static vSched_stats unrecordedStats; // used if a slot can't be allocated
+
+static vSched_stats* vSched_thread_stats(void)
+{
+  if (myStatsSlot == NULL)
+    {
+      size_t size = (sizeof(vSched_stats_slot) + VSCHED_CACHE_LINE - 1)/VSCHED_CACHE_LINE*VSCHED_CACHE_LINE;
+      vSched_stats_slot* slot = NULL;
+      if (posix_memalign((void**)&slot, VSCHED_CACHE_LINE, size) != 0)
+	return &unrecordedStats;
+      memset(slot, 0, size);
+      pthread_mutex_lock(&init_lock);
+      slot->next = statsSlots;
+      statsSlots = slot;
+      pthread_mutex_unlock(&init_lock);
+      myStatsSlot = slot;
+    }
+  return &myStatsSlot->stats;
+}
+
+static void vSched_stats_dequeue(double t0, int found, int *pstart, int *pend)
+{
+  vSched_stats* stats = vSched_thread_stats();
+  stats->dequeueTime += vSched_now() - t0;
+  if (found && *pstart < *pend) stats->chunks++;
+}
+
+#define VSCHED_STATS_STEAL(ok) \
+  do { if (ok) vSched_thread_stats()->stolen++; else vSched_thread_stats()->failedSteals++; } while (0)
+
+/*
+  Defines loop_next_<name>_ctx() from next_<name>(), recording the time and
+  the outcome of every dequeue.
+*/
+#define VSCHED_DEFINE_LOOP_NEXT(name) \
+  int loop_next_##name##_ctx(vSched_context* ctx, int *pstart, int *pend, int tid) \
+  { \
+    double t0 = vSched_now(); \
+    int found = next_##name(ctx, pstart, pend, tid); \
+    vSched_stats_dequeue(t0, found, pstart, pend); \
+    return found; \
+  }
+
+#else
+
+#define VSCHED_STATS_STEAL(ok) do { } while (0)
 
- PossibleWork** dynwork; 
-int selectAnotherThread(int tid, int numThreads);
+#define VSCHED_DEFINE_LOOP_NEXT(name) \
+  int loop_next_##name##_ctx(vSched_context* ctx, int *pstart, int *pend, int tid) \
+  { \
+    return next_##name(ctx, pstart, pend, tid); \
+  }
+
+#endif
+
+#if defined(RAJA_ENABLE_LWS_TRACE)
+/* the thread the last chunk handed to this thread was stolen from, or -1 */
+static __thread int stolenFrom = -1;
+
+#define VSCHED_TRACE_STEAL(victim) do { stolenFrom = (victim); } while (0)
+#else
+#define VSCHED_TRACE_STEAL(victim) do { } while (0)
+#endif
+
+// functions internal to the vSched library
+int selectAnotherThread(vSched_context* ctx, int tid, int numThreads);
 
 int vSched_thread_init()
-{ 
+{
   // allocate the data structure for each thread
+  return 0;
 }
 
-void vSched_init(int numThreads)
+/*
+  Makes sure ctx has queues for numThreads threads. The queues are only
+  reallocated when numThreads grows beyond what was allocated before, so this
+  is cheap to call before every loop. Returns 0 on success.
+*/
+static int vSched_context_reserve(vSched_context* ctx, int numThreads)
 {
-  static bool isInited = false;
-  if(!isInited)
+  int rc = 0;
+  if (numThreads <= __atomic_load_n(&ctx->threadCount, __ATOMIC_ACQUIRE))
+    return 0;
+  pthread_mutex_lock(&init_lock);
+  if (numThreads > ctx->threadCount)
     {
-      isInited = true;
-      pthread_mutex_init(&sched_lock, NULL);
-      threadCount = numThreads;
-      dynwork = (PossibleWork**) malloc(sizeof(void*)*numThreads);
-      for (int i = 0 ; i < numThreads; i++)
+      PossibleWork* queues = NULL;
+      if (posix_memalign((void**)&queues, VSCHED_CACHE_LINE, sizeof(PossibleWork)*numThreads) != 0)
+	{
+	  rc = 1;
+	}
+      else
 	{
-	  dynwork[i] =  (PossibleWork*) malloc(sizeof(PossibleWork));
-	  pthread_mutex_init(&(dynwork[i]->qLock), NULL);
+	  for (int i = 0 ; i < numThreads; i++)
+	    {
+	      queues[i].work = vSched_pack(0, 0); // a queue is empty when next >= limit
+	      queues[i].rngState = 0x9E3779B97F4A7C15ULL * (uint64_t)(i + 1);
+	      queues[i].draws = 0;
+	      queues[i].chunkSize = ctx->chunkSize;
+	      queues[i].lastVictim = i;
+	      queues[i].steals = 0;
+	      queues[i].sharedLoop = __atomic_load_n(&ctx->sharedLoop, __ATOMIC_ACQUIRE);
+	    }
+	  free(ctx->dynwork);
+	  ctx->dynwork = queues;
+	  __atomic_store_n(&ctx->threadCount, numThreads, __ATOMIC_RELEASE);
 	}
     }
+  pthread_mutex_unlock(&init_lock);
+  return rc;
+}
+
+static void vSched_context_pool_init()
+{
+  for (int i = 0; i < VSCHED_POOL_SIZE; i++)
+    {
+      pthread_mutex_init(&contextPool[i].sched_lock, NULL);
+      contextPool[i].pooled = 1;
+    }
+}
+
+/*
+  Hands out a context for one loop run by numThreads threads, with the current
+  default schedule parameters. Contexts come from a small pool whose queues
+  are kept between loops, so steady-state use does not allocate. Returns NULL
+  if the queues could not be allocated.
+*/
+vSched_context* vSched_context_acquire(int numThreads)
+{
+  vSched_context* ctx = NULL;
+  pthread_once(&contextPoolOnce, vSched_context_pool_init);
+  for (int i = 0; i < VSCHED_POOL_SIZE && ctx == NULL; i++)
+    {
+      int expected = 0;
+      if (__atomic_compare_exchange_n(&contextPool[i].inUse, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+	ctx = &contextPool[i];
+    }
+  if (ctx == NULL) // every pooled context is in use
+    {
+      ctx = (vSched_context*) calloc(1, sizeof(vSched_context));
+      if (ctx == NULL) return NULL;
+      pthread_mutex_init(&ctx->sched_lock, NULL);
+      ctx->inUse = 1;
+    }
+  ctx->f_s = defaultContext.f_s;
+  ctx->f_d = defaultContext.f_d;
+  ctx->constraint_ = defaultContext.constraint_;
+  ctx->chunkSize = defaultContext.chunkSize;
+  ctx->victimSelection = defaultContext.victimSelection;
+  ctx->stealHalf = defaultContext.stealHalf;
+  ctx->crossSocketThreshold = defaultContext.crossSocketThreshold;
+  ctx->cdyConstraint = defaultContext.cdyConstraint;
+  ctx->cdyConstraintArg = defaultContext.cdyConstraintArg;
+  ctx->numThreads = numThreads;
+  ctx->count = 0;
+  ctx->isLoopStarted = 0;
+  if (vSched_context_reserve(ctx, numThreads) != 0)
+    {
+      vSched_context_release(ctx);
+      return NULL;
+    }
+  return ctx;
+}
+
+/*
+  Returns a context to the pool once every thread is done with its loop.
+*/
+void vSched_context_release(vSched_context* ctx)
+{
+  if (ctx->pooled)
+    {
+      __atomic_store_n(&ctx->inUse, 0, __ATOMIC_RELEASE);
+    }
+  else
+    {
+      pthread_mutex_destroy(&ctx->sched_lock);
+      free(ctx->dynwork);
+      free(ctx);
+    }
+}
+
+void vSched_context_set_static_fraction(vSched_context* ctx, float f, int _chunkSize)
+{
+  ctx->f_s = f;
+  ctx->chunkSize = _chunkSize;
+}
+
+void vSched_context_set_cdy_constraint(vSched_context* ctx, vSched_cdy_constraint constraint, void* arg)
+{
+  ctx->cdyConstraint = constraint;
+  ctx->cdyConstraintArg = arg;
+}
+
+void vSched_init(int numThreads)
+{
+  vSched_context_reserve(&defaultContext, numThreads);
 }
 
 
 void vSched_finalize(int numThreads)
 {
-  pthread_mutex_destroy(&sched_lock);
+  (void)numThreads;
+  pthread_mutex_lock(&init_lock);
+  free(defaultContext.dynwork);
+  defaultContext.dynwork = NULL;
+  __atomic_store_n(&defaultContext.threadCount, 0, __ATOMIC_RELEASE);
+  pthread_mutex_unlock(&init_lock);
 }
 
 
 void setStaticFraction(float f, int _chunkSize)
 {
-  f_s = f;
-  chunkSize = _chunkSize;
-  isLoopStarted = 0;
+  defaultContext.f_s = f;
+  defaultContext.chunkSize = _chunkSize;
+  defaultContext.isLoopStarted = 0;
+}
+
+void setStealStrategy(int _victimSelection, int _stealHalf)
+{
+  defaultContext.victimSelection = _victimSelection;
+  defaultContext.stealHalf = _stealHalf;
+}
+
+/*
+  With VSCHED_VICTIM_HIERARCHICAL, a thief only steals from a thread on
+  another socket if that thread has at least minChunks chunks left, since
+  moving data across sockets costs more than a few chunks of imbalance.
+  0 always allows it, -1 never does.
+*/
+void setCrossSocketThreshold(int minChunks)
+{
+  defaultContext.crossSocketThreshold = minChunks;
 }
 
 
 void setCDY(float f, double c, int _chunkSize)
 {
-  f_s = f; f_d = 1.0 - f; constraint_ = c; chunkSize = _chunkSize; isLoopStarted = 0;
+  vSched_context* ctx = &defaultContext;
+  ctx->f_s = f; ctx->f_d = 1.0 - f; ctx->constraint_ = c; ctx->chunkSize = _chunkSize; ctx->isLoopStarted = 0;
+}
+
+void setCDYConstraint(vSched_cdy_constraint constraint, void* arg)
+{
+  vSched_context_set_cdy_constraint(&defaultContext, constraint, arg);
+}
+
+/*
+  Static scheduling: each thread gets one contiguous block and nothing else.
+*/
+int loop_start_static(int loopBegin, int loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  *pstart = loopBegin + (int)(((long long)(loopEnd - loopBegin)*threadID)/numThreads);
+  *pend = loopBegin + (int)(((long long)(loopEnd - loopBegin)*(threadID+1))/numThreads);
+  return 1;
+}
+
+int loop_next_static(int *pstart, int *pend)
+{
+  (void)pstart; (void)pend;
+  return 0;
 }
 
 /*
-  this is the initialization function for the constrained dynamic scheduling
+  Static fraction scheduling: the first f_s of the iterations are split into
+  one block per thread, and the rest is handed out in chunks from a single
+  shared counter.
 */
-int loop_start_cdy(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads )  // think about adding to parameter list here
+/*
+  Starts a loop whose dynamic part is handed out from one shared counter, and
+  returns the static part of the calling thread in *pstart and *pend. The
+  first thread to arrive sets the counter up (isLoopStarted goes 0 -> 1 -> 2)
+  and numbers the loop; the others wait for it. A thread that arrives while
+  the loop it ran before is still running, because other threads have not
+  run out of chunks yet, waits until the last of them resets isLoopStarted in
+  finishSharedLoop(), so back-to-back loops on one context, as with the
+  default context, each get their own counter. Every one of the numThreads
+  threads has to run the loop until loop_next_*() returns 0.
+  If ctx has no queues for numThreads threads and they can't be allocated,
+  the loop falls back to a static schedule: the thread gets its block of the
+  whole loop, loop_next_*() finds the counter of the last loop used up, and
+  0 is returned.
+*/
+static int startSharedLoop(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
 {
-  pthread_mutex_lock(&sched_lock);
-// printf("loop_start_cdy(): thread %d \n", threadID);
-  if(!isLoopStarted)
+  int dynBegin = loopBegin + (int)((_loopEnd - loopBegin)*ctx->f_s);
+  PossibleWork* q;
+  if (dynBegin > _loopEnd) dynBegin = _loopEnd;
+  if (vSched_context_reserve(ctx, numThreads) != 0)
   {
-    loopEnd = _loopEnd;
-    nextChunk = loopBegin + (loopEnd - loopBegin)*f_s;
-    isLoopStarted = 1;
-    #ifdef VERBOSE
-      printf("loop_start_cdy(): thread %d : isLoopStarted = %d \t nextChunk = %d \t loopEnd = %d \n", threadID, isLoopStarted, nextChunk, loopEnd);
-      #endif
+    loop_start_static(loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+    return 0;
   }
-  pthread_mutex_unlock(&sched_lock);
-  *pstart = loopBegin + (((loopEnd - loopBegin)*threadID)*f_s)/numThreads; /* figure out algebra  here , based on loopBegin */
-  *pend = loopBegin + (((loopEnd - loopBegin)*(threadID+1))*f_s)/numThreads; /* figure out algebra  here , based on loopBegin, check */
-// print ostart pend
-#ifdef VERBOSE
-    printf("thread%d:\t pstart =  %d \t pend = %d \t nextChunk = %d \n ", threadID, *pstart, *pend, nextChunk);
-#endif
- return 1;
+  q = &ctx->dynwork[threadID];
+  for (;;)
+  {
+    int expected = 0;
+    int state = __atomic_load_n(&ctx->isLoopStarted, __ATOMIC_ACQUIRE);
+    if (state == 2 && __atomic_load_n(&ctx->sharedLoop, __ATOMIC_ACQUIRE) != q->sharedLoop)
+      break; // another thread set this loop up
+    if (state == 0 && __atomic_compare_exchange_n(&ctx->isLoopStarted, &expected, 1, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+      ctx->loopEnd = _loopEnd;
+      ctx->dynBegin = dynBegin;
+      ctx->nextChunk = dynBegin;
+      ctx->nextChunkIndex = 0;
+      ctx->numThreads = numThreads;
+      ctx->finished = 0;
+      ctx->loopStartTime = vSched_now();
+      __atomic_store_n(&ctx->sharedLoop, ctx->sharedLoop + 1, __ATOMIC_RELEASE);
+      __atomic_store_n(&ctx->isLoopStarted, 2, __ATOMIC_RELEASE);
+      break;
+    }
+    // the counter is being set up, or the previous loop is still running on
+    // threads that may need this one's time slice to finish it
+    sched_yield();
+  }
+  q->sharedLoop = ctx->sharedLoop;
+  *pstart = loopBegin + (int)(((long long)(dynBegin - loopBegin)*threadID)/numThreads);
+  *pend = loopBegin + (int)(((long long)(dynBegin - loopBegin)*(threadID+1))/numThreads);
+  return 1;
+}
+
+/*
+  Called by loop_next_*() when it hands out no more chunks: the last thread
+  to get there ends the loop, so that the next one sets the counter up again.
+*/
+static int finishSharedLoop(vSched_context* ctx)
+{
+  if (__atomic_add_fetch(&ctx->finished, 1, __ATOMIC_ACQ_REL) == ctx->numThreads)
+    __atomic_store_n(&ctx->isLoopStarted, 0, __ATOMIC_RELEASE);
+  return 0;
+}
+
+static int minChunkSize(const vSched_context* ctx)
+{
+  return (ctx->chunkSize > 0) ? ctx->chunkSize : 1;
+}
+
+int loop_start_static_fraction_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return startSharedLoop(ctx, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+static int next_static_fraction(vSched_context* ctx, int *pstart, int *pend, int tid)
+{
+  int chunk = minChunkSize(ctx);
+  (void)tid;
+  *pstart = __atomic_fetch_add(&ctx->nextChunk, chunk, __ATOMIC_RELAXED);
+  if (*pstart >= ctx->loopEnd) return finishSharedLoop(ctx);
+  *pend = (*pstart < ctx->loopEnd - chunk) ? *pstart + chunk : ctx->loopEnd;
+  return 1;
+}
+
+VSCHED_DEFINE_LOOP_NEXT(static_fraction)
+
+int loop_start_static_fraction(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return loop_start_static_fraction_ctx(&defaultContext, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+int loop_next_static_fraction(int *pstart, int *pend)
+{
+  return loop_next_static_fraction_ctx(&defaultContext, pstart, pend, 0);
+}
+
+/*
+  Guided self-scheduling: each chunk of the dynamic part is the work that is
+  left divided by the number of threads, but at least chunkSize, so chunks
+  start large and shrink towards the end of the loop.
+*/
+int loop_start_guided_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return startSharedLoop(ctx, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+static int next_guided(vSched_context* ctx, int *pstart, int *pend, int tid)
+{
+  int minChunk = minChunkSize(ctx);
+  int start, chunk;
+  (void)tid;
+  start = __atomic_load_n(&ctx->nextChunk, __ATOMIC_RELAXED);
+  do
+    {
+      if (start >= ctx->loopEnd) return finishSharedLoop(ctx);
+      chunk = (ctx->loopEnd - start + ctx->numThreads - 1)/ctx->numThreads;
+      if (chunk < minChunk) chunk = minChunk;
+      if (chunk > ctx->loopEnd - start) chunk = ctx->loopEnd - start;
+    }
+  while (!__atomic_compare_exchange_n(&ctx->nextChunk, &start, start + chunk, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+  *pstart = start;
+  *pend = start + chunk;
+  return 1;
+}
+
+VSCHED_DEFINE_LOOP_NEXT(guided)
+
+int loop_start_guided(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return loop_start_guided_ctx(&defaultContext, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+int loop_next_guided(int *pstart, int *pend, int tid)
+{
+  return loop_next_guided_ctx(&defaultContext, pstart, pend, tid);
+}
+
+/*
+  Factoring (FAC2): the dynamic part is handed out in batches of numThreads
+  equal chunks, each batch covering half of the work that was left when it
+  started, with chunks of at least chunkSize. The bounds of a chunk follow
+  from its index, so taking a chunk is a single fetch-add; finding the batch
+  of an index takes O(log(iterations)) steps.
+*/
+static long long factoringStart(const vSched_context* ctx, long long index, long long *size)
+{
+  long long remaining = ctx->loopEnd - ctx->dynBegin;
+  long long pos = ctx->dynBegin;
+  int minChunk = minChunkSize(ctx);
+  int p = ctx->numThreads;
+  for (;;)
+    {
+      *size = (remaining + 2LL*p - 1)/(2LL*p);
+      if (*size <= minChunk) // every later batch has minChunk chunks too
+	{
+	  *size = minChunk;
+	  return pos + index*minChunk;
+	}
+      if (index < p)
+	return pos + index*(*size);
+      pos += p*(*size);
+      remaining -= p*(*size);
+      index -= p;
+    }
+}
+
+int loop_start_factoring_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return startSharedLoop(ctx, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+static int next_factoring(vSched_context* ctx, int *pstart, int *pend, int tid)
+{
+  long long start, size;
+  (void)tid;
+  start = factoringStart(ctx, __atomic_fetch_add(&ctx->nextChunkIndex, 1, __ATOMIC_RELAXED), &size);
+  if (start >= ctx->loopEnd) return finishSharedLoop(ctx);
+  *pstart = (int)start;
+  *pend = (start + size < ctx->loopEnd) ? (int)(start + size) : ctx->loopEnd;
+  return 1;
+}
+
+VSCHED_DEFINE_LOOP_NEXT(factoring)
+
+int loop_start_factoring(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return loop_start_factoring_ctx(&defaultContext, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+int loop_next_factoring(int *pstart, int *pend, int tid)
+{
+  return loop_next_factoring_ctx(&defaultContext, pstart, pend, tid);
+}
+
+/*
+  Trapezoid self-scheduling: the sizes of the chunks of the dynamic part
+  decrease linearly, from (dynamic work)/(2*numThreads) for the first chunk to
+  chunkSize for the last. Returns the offset of chunk index in the dynamic
+  part; like factoring, a chunk is taken with a single fetch-add.
+*/
+static long long trapezoidStart(const vSched_context* ctx, long long index)
+{
+  long long total = ctx->loopEnd - ctx->dynBegin;
+  long long last = minChunkSize(ctx);
+  long long first = (total + 2LL*ctx->numThreads - 1)/(2LL*ctx->numThreads);
+  long long numChunks, lastIndex;
+  double delta;
+  if (first < last) first = last;
+  numChunks = (2*total + first + last - 1)/(first + last);
+  if (numChunks < 1) numChunks = 1;
+  delta = (numChunks > 1) ? (double)(first - last)/(numChunks - 1) : 0.0;
+  // chunks after the last planned one (only reached because of rounding) have size last
+  lastIndex = (index < numChunks - 1) ? index : numChunks - 1;
+  return (long long)(lastIndex*first - delta*lastIndex*(lastIndex - 1)/2.0) + (index - lastIndex)*last;
+}
+
+int loop_start_trapezoid_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return startSharedLoop(ctx, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+static int next_trapezoid(vSched_context* ctx, int *pstart, int *pend, int tid)
+{
+  long long index, start, end;
+  (void)tid;
+  index = __atomic_fetch_add(&ctx->nextChunkIndex, 1, __ATOMIC_RELAXED);
+  start = ctx->dynBegin + trapezoidStart(ctx, index);
+  if (start >= ctx->loopEnd) return finishSharedLoop(ctx);
+  end = ctx->dynBegin + trapezoidStart(ctx, index + 1);
+  *pstart = (int)start;
+  *pend = (end < ctx->loopEnd) ? (int)end : ctx->loopEnd;
+  return 1;
+}
+
+VSCHED_DEFINE_LOOP_NEXT(trapezoid)
+
+int loop_start_trapezoid(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return loop_start_trapezoid_ctx(&defaultContext, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+int loop_next_trapezoid(int *pstart, int *pend, int tid)
+{
+  return loop_next_trapezoid_ctx(&defaultContext, pstart, pend, tid);
+}
+
+/*
+  Constrained dynamic scheduling: like static fraction scheduling, but a
+  thread only takes a chunk of the dynamic part when the constraint lets it
+  (see vSched_cdy_constraint); otherwise it gets an empty chunk and asks
+  again. Chunks come from the shared counter with a fetch-add, and every
+  thread draws its random numbers from its own counter-based generator, so
+  nothing is locked.
+*/
+int loop_start_cdy_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return startSharedLoop(ctx, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+/*
+  The draw-th random number of thread tid, uniform in [0, 1): a function of
+  the pair, so the sequence of each thread is fixed and no state is shared
+  between threads.
+*/
+static inline double cdy_random(int tid, uint64_t draw)
+{
+  return vSched_uniform(((uint64_t)(tid + 1) << 40) ^ draw);
+}
+
+static int cdy_allows(vSched_context* ctx, int tid, int next)
+{
+  vSched_cdy_state state;
+  // without a queue to count its draws in, the thread is never held back
+  if (tid >= __atomic_load_n(&ctx->threadCount, __ATOMIC_ACQUIRE)) return 1;
+  state.random = cdy_random(tid, ctx->dynwork[tid].draws++);
+  state.constraint = ctx->constraint_;
+  if (ctx->cdyConstraint == NULL) return state.random < state.constraint;
+  state.tid = tid;
+  state.numThreads = ctx->numThreads;
+  state.dynBegin = ctx->dynBegin;
+  state.next = next;
+  state.loopEnd = ctx->loopEnd;
+  state.elapsed = vSched_now() - ctx->loopStartTime;
+  return ctx->cdyConstraint(&state, ctx->cdyConstraintArg) != 0;
 }
 
 /*
     return 0 means that there is no more work
  */
+static int next_cdy(vSched_context* ctx, int *pstart, int *pend, int tid)
+{
+  int chunk = minChunkSize(ctx);
+  int next;
+  next = __atomic_load_n(&ctx->nextChunk, __ATOMIC_RELAXED);
+  if (next >= ctx->loopEnd) return finishSharedLoop(ctx);
+  if (!cdy_allows(ctx, tid, next))
+  {
+    // the constraint is not satisfied, so the thread gets a dummy piece of work and dequeues again
+    *pstart = 0;
+    *pend = 0;
+    return 1;
+  }
+  *pstart = __atomic_fetch_add(&ctx->nextChunk, chunk, __ATOMIC_RELAXED);
+  if (*pstart >= ctx->loopEnd) return finishSharedLoop(ctx);
+  *pend = (*pstart < ctx->loopEnd - chunk) ? *pstart + chunk : ctx->loopEnd;
+  return 1;
+}
+
+VSCHED_DEFINE_LOOP_NEXT(cdy)
+
+int loop_start_cdy(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return loop_start_cdy_ctx(&defaultContext, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
 int loop_next_cdy(int *pstart, int *pend, int tid)
 {
-#ifdef VERBOSE
-  printf("starting loop_next_cdy() \t pstart %d \t pend %d \n", *pstart, *pend);
-#endif
-  if(isLoopStarted == 0)
-    return 0;
+  return loop_next_cdy_ctx(&defaultContext, pstart, pend, tid);
+}
 
-#ifdef PROFILING
-  double time_loop_next = 0.0;
-  time_loop_next = - vSched_get_wtime();
-#endif
-  pthread_mutex_lock(&sched_lock);
-  if((nextChunk  >=  loopEnd)  && (isLoopStarted == 1)) // if next chunk greater than end bound, and no one else noticed
+/*
+  The cache group (the CPUs that share a last-level cache) and socket of
+  every CPU, for VSCHED_VICTIM_HIERARCHICAL.
+*/
+typedef struct vSched_topology
+{
+  int numCpus;
+  int simulated;
+  int* cacheGroup;
+  int* socket;
+} vSched_topology;
+
+static vSched_topology* topology = NULL;
+static pthread_once_t topologyOnce = PTHREAD_ONCE_INIT;
+
+static int read_sys_int(int cpu, const char* file, int* value)
+{
+  char path[128];
+  FILE* f;
+  int rc;
+  snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/%s", cpu, file);
+  f = fopen(path, "r");
+  if (f == NULL) return 0;
+  rc = fscanf(f, "%d", value);
+  fclose(f);
+  return rc == 1;
+}
+
+static vSched_topology* topology_alloc(int numCpus)
+{
+  vSched_topology* topo = (vSched_topology*) calloc(1, sizeof(vSched_topology));
+  if (topo == NULL) return NULL;
+  topo->numCpus = numCpus;
+  topo->cacheGroup = (int*) calloc(numCpus, sizeof(int));
+  topo->socket = (int*) calloc(numCpus, sizeof(int));
+  if (topo->cacheGroup == NULL || topo->socket == NULL)
+    {
+      free(topo->cacheGroup);
+      free(topo->socket);
+      free(topo);
+      return NULL;
+    }
+  return topo;
+}
+
+static void topology_free(vSched_topology* topo)
+{
+  if (topo == NULL) return;
+  free(topo->cacheGroup);
+  free(topo->socket);
+  free(topo);
+}
+
+/*
+  Reads the topology from sysfs. A CPU without a level 3 cache is its own
+  socket's cache group; a CPU without topology information is on socket 0.
+*/
+static vSched_topology* topology_from_sys(void)
+{
+  long numCpus = sysconf(_SC_NPROCESSORS_CONF);
+  vSched_topology* topo;
+  if (numCpus < 1) numCpus = 1;
+  topo = topology_alloc((int)numCpus);
+  if (topo == NULL) return NULL;
+  for (int cpu = 0; cpu < topo->numCpus; cpu++)
+    {
+      int socket = 0, group;
+      read_sys_int(cpu, "topology/physical_package_id", &socket);
+      if (!read_sys_int(cpu, "cache/index3/id", &group))
+	group = socket;
+      topo->socket[cpu] = socket;
+      // cache ids are only unique within a socket on some systems
+      topo->cacheGroup[cpu] = socket*65536 + group;
+    }
+  return topo;
+}
+
+static vSched_topology* topology_from_description(const char* description)
+{
+  int numCpus = 0;
+  const char* p = description;
+  vSched_topology* topo;
+  int socket, group, n;
+  while (sscanf(p, " %d:%d%n", &socket, &group, &n) == 2)
+    {
+      numCpus++;
+      p += n;
+    }
+  while (*p == ' ' || *p == '\t' || *p == '\n') p++;
+  if (numCpus == 0 || *p != '\0') return NULL;
+  topo = topology_alloc(numCpus);
+  if (topo == NULL) return NULL;
+  topo->simulated = 1;
+  p = description;
+  for (int cpu = 0; cpu < numCpus; cpu++)
+    {
+      sscanf(p, " %d:%d%n", &socket, &group, &n);
+      topo->socket[cpu] = socket;
+      topo->cacheGroup[cpu] = socket*65536 + group;
+      p += n;
+    }
+  return topo;
+}
+
+static void topology_init(void)
+{
+  const char* description = getenv("VSCHED_TOPOLOGY");
+  vSched_topology* topo = (description != NULL) ? topology_from_description(description) : NULL;
+  if (topo == NULL) topo = topology_from_sys();
+  __atomic_store_n(&topology, topo, __ATOMIC_RELEASE);
+}
+
+int vSched_set_topology(const char* description)
+{
+  vSched_topology* topo;
+  pthread_once(&topologyOnce, topology_init);
+  topo = (description != NULL) ? topology_from_description(description) : topology_from_sys();
+  if (topo == NULL) return -1;
+  topology_free(__atomic_exchange_n(&topology, topo, __ATOMIC_ACQ_REL));
+  return 0;
+}
+
+/*
+  Finds the cache group and socket of the CPU that thread tid runs on. Where
+  OpenMP binds its threads (OMP_PROC_BIND), this is where the thread stays.
+*/
+static void vSched_locate_thread(vSched_context* ctx, int tid)
+{
+  vSched_topology* topo;
+  int cpu;
+  pthread_once(&topologyOnce, topology_init);
+  topo = __atomic_load_n(&topology, __ATOMIC_ACQUIRE);
+  cpu = (topo != NULL && topo->simulated) ? tid % topo->numCpus : sched_getcpu();
+  if (topo == NULL || cpu < 0 || cpu >= topo->numCpus)
+    {
+      __atomic_store_n(&ctx->dynwork[tid].cacheGroup, 0, __ATOMIC_RELAXED);
+      __atomic_store_n(&ctx->dynwork[tid].socket, 0, __ATOMIC_RELAXED);
+      return;
+    }
+  __atomic_store_n(&ctx->dynwork[tid].cacheGroup, topo->cacheGroup[cpu], __ATOMIC_RELAXED);
+  __atomic_store_n(&ctx->dynwork[tid].socket, topo->socket[cpu], __ATOMIC_RELAXED);
+}
+
+/*
+  Sets up the queue of threadID for a loop and hands it [begin, limit).
+*/
+static void publish_queue(vSched_context* ctx, int threadID, int begin, int limit)
+{
+  PossibleWork* q = &ctx->dynwork[threadID];
+  q->chunkSize = (ctx->chunkSize > 0) ? ctx->chunkSize : 1;
+  q->steals = 0;
+  if (ctx->victimSelection == VSCHED_VICTIM_HIERARCHICAL)
+    vSched_locate_thread(ctx, threadID);
+  if (begin < limit) // this thread has dynamic work in its own queue
   {
-    isLoopStarted = 0;  /* protect with lock, or make only thread 0 do it */
-    /* might be good place to do tasklet locality here */
+    // count the queue before publishing it, so a thief that drains it never takes count below zero
+    __atomic_fetch_add(&ctx->count, 1, __ATOMIC_ACQ_REL);
+    // the queue was left empty by the previous loop, and nobody but its owner writes an empty queue
+    __atomic_store_n(&q->work, vSched_pack(begin, limit), __ATOMIC_RELEASE);
+  }
+}
+
+int loop_start_statdynstaggered_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads )  // think about adding to parameter list here
+{
+  int limit;
+  vSched_context_reserve(ctx, numThreads);
+  __atomic_store_n(&ctx->numThreads, numThreads, __ATOMIC_RELAXED);
+  limit = loopBegin + (int)(((long long)(_loopEnd - loopBegin)*(threadID+1))/numThreads);
+  *pstart = loopBegin + (int)(((long long)(_loopEnd - loopBegin)*threadID)/numThreads); /* figure out algebra  here , based on loopBegin */
+  *pend = *pstart + (int)(((_loopEnd - loopBegin)*ctx->f_s)/numThreads); /* figure out algebra  here , based on loopBegin, check */
+  if (*pend > limit) *pend = limit;
+  publish_queue(ctx, threadID, *pend, limit);
+// print ostart pend
 #ifdef VERBOSE
-    printf("loop ended\n");
+    printf("thread%d:\t pstart =  %d \t pend = %d \t limit = %d \n ", threadID, *pstart, *pend, limit);
 #endif
+  return 1;
+}
 
-#ifdef PROFILING
-    time_loop_next += vSched_get_wtime();
-    printf("loop_next_sds(): loop ended: thread %d \t dequeue time = %f  \n" , tid, time_loop_next);
-#endif
-    pthread_mutex_unlock(&sched_lock);
-    return 0;
-  }
-  if(get_constraint())
+/*
+  Starts a statdynstaggered loop in which threadID was given the iterations
+  [rangeBegin, rangeEnd) rather than its share of the whole loop: the first
+  f_s of them are its static part, and the rest go into its queue. For
+  replaying a recorded assignment with stealing. Returns 0, with the whole
+  range as the static part, if the queues could not be allocated.
+*/
+int loop_start_statdynstaggered_range_ctx(vSched_context* ctx, int rangeBegin, int rangeEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  *pstart = rangeBegin;
+  *pend = rangeEnd;
+  if (vSched_context_reserve(ctx, numThreads) != 0) return 0;
+  __atomic_store_n(&ctx->numThreads, numThreads, __ATOMIC_RELAXED);
+  *pend = rangeBegin + (int)((rangeEnd - rangeBegin)*ctx->f_s);
+  if (*pend > rangeEnd) *pend = rangeEnd;
+  publish_queue(ctx, threadID, *pend, rangeEnd);
+  return 1;
+}
+
+static inline int vSched_remaining(vSched_context* ctx, int t)
+{
+  uint64_t w = __atomic_load_n(&ctx->dynwork[t].work, __ATOMIC_RELAXED);
+  return (vSched_next(w) < vSched_limit(w)) ? (int)(vSched_limit(w) - vSched_next(w)) : 0;
+}
+
+/*
+  xorshift64* generator, one state per thread so thieves never share it.
+*/
+static inline uint32_t vSched_rand(vSched_context* ctx, int tid)
+{
+  uint64_t x = ctx->dynwork[tid].rngState;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  ctx->dynwork[tid].rngState = x;
+  return (uint32_t)((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+/*
+  Probes up to numThreads random victims.
+*/
+static int select_victim_random(vSched_context* ctx, int tid, int numThreads)
+{
+  for (int probe = 0; probe < numThreads; probe++)
   {
-    *pstart = nextChunk;
-    nextChunk = nextChunk + chunkSize;
-    *pend  = nextChunk;
+    int t = (int)(vSched_rand(ctx, tid) % (uint32_t)(numThreads - 1));
+    if (t >= tid) t++; // never pick ourselves
+    if (vSched_remaining(ctx, t) > 0) return t;
   }
-  else // the constraint is not satisfied, so we make the thread do a dummy piece of work
+  return -1;
+}
+
+/*
+  Probes every other thread once, starting after the last thread stolen from.
+*/
+static int select_victim_round_robin(vSched_context* ctx, int tid, int numThreads)
+{
+  int t = ctx->dynwork[tid].lastVictim;
+  for (int probe = 0; probe < numThreads; probe++)
   {
-#ifdef VERBOSE
-    printf("condition not passed. Thread working on dummy tasklet, and then dequeueing again.\n");
-#endif
-    *pstart = 0;  // this should generate bus traffic, it's only hitting registers
-    *pend = 0;
+    t = (t + 1) % numThreads;
+    if (t != tid && vSched_remaining(ctx, t) > 0)
+    {
+      ctx->dynwork[tid].lastVictim = t;
+      return t;
+    }
   }
-  pthread_mutex_unlock(&sched_lock);
-#ifdef VERBOSE
-    printf(" Loop_next_cdy(): \t pstart =  %d \t pend = %d \t nextChunk = %d \n ", *pstart, *pend, nextChunk);
-#endif
-  if(*pend  > loopEnd)
-    *pend = loopEnd;
-
-#ifdef PROFILING
-  time_loop_next += vSched_get_wtime();
-  printf("loop_next_sds(): thread %d \t dequeue time = %f  \n" ,tid, time_loop_next);
-#endif
+  return -1;
+}
 
-  return 1;
+/*
+  Picks the thread with the most work left in its queue.
+*/
+static int select_victim_most_work(vSched_context* ctx, int tid, int numThreads)
+{
+  int another_tid = -1;
+  int most = 0;
+  for (int t = 0; t < numThreads; t++)
+  {
+    int r = (t != tid) ? vSched_remaining(ctx, t) : 0;
+    if (r > most)
+    {
+      most = r;
+      another_tid = t;
+    }
+  }
+  return another_tid;
 }
 
-int loop_start_statdynstaggered(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads )  // think about adding to parameter list here
-{
-  pthread_mutex_lock(&sched_lock); // check if the lock is needed around the whole conditional clause
-  if(count == 0)
-    count = numThreads;
-  pthread_mutex_unlock(&sched_lock);
-  pthread_mutex_lock(&dynwork[threadID]->qLock);
-// printf("loop_start_cdy(): thread %d \n", threadID);
-  loopEnd = _loopEnd;
-  dynwork[threadID]->limit = loopBegin + ((loopEnd - loopBegin)*(threadID+1))/numThreads;
-  *pstart = loopBegin + (((loopEnd - loopBegin)*threadID))/numThreads; /* figure out algebra  here , based on loopBegin */
-  *pend = *pstart + ((loopEnd - loopBegin)*f_s)/numThreads; /* figure out algebra  here , based on loopBegin, check */
-  dynwork[threadID]->nextChunk = *pend;
-  dynwork[threadID]->chunkSize = chunkSize;
-  pthread_mutex_unlock(&(dynwork[threadID]->qLock));
-  if (dynwork[threadID]->nextChunk >= dynwork[threadID]->limit) // this thread is done with its own queue
+/*
+  Picks the thread with the most work left among the threads that share a
+  cache with tid, else among those on its socket, else among those on other
+  sockets that have at least crossSocketThreshold chunks left.
+*/
+static int select_victim_hierarchical(vSched_context* ctx, int tid, int numThreads)
+{
+  int group = __atomic_load_n(&ctx->dynwork[tid].cacheGroup, __ATOMIC_RELAXED);
+  int socket = __atomic_load_n(&ctx->dynwork[tid].socket, __ATOMIC_RELAXED);
+  int best[3] = {-1, -1, -1};
+  int most[3] = {0, 0, 0};
+  for (int t = 0; t < numThreads; t++)
   {
-    pthread_mutex_lock(&sched_lock);
-    count--;
-    pthread_mutex_unlock(&sched_lock);
+    int r = (t != tid) ? vSched_remaining(ctx, t) : 0;
+    int level;
+    if (r == 0) continue;
+    if (__atomic_load_n(&ctx->dynwork[t].socket, __ATOMIC_RELAXED) != socket)
+      level = 2;
+    else if (__atomic_load_n(&ctx->dynwork[t].cacheGroup, __ATOMIC_RELAXED) != group)
+      level = 1;
+    else
+      level = 0;
+    if (r > most[level])
+    {
+      most[level] = r;
+      best[level] = t;
+    }
   }
-// print ostart pend
-#ifdef VERBOSE
-    printf("thread%d:\t pstart =  %d \t pend = %d \t nextChunk = %d \n ", threadID, *pstart, *pend, dynwork[threadID]->nextChunk);
-#endif
-  return 1;
+  if (best[0] != -1) return best[0];
+  if (best[1] != -1) return best[1];
+  if (best[2] != -1 && ctx->crossSocketThreshold >= 0
+      && most[2] >= (long long)ctx->crossSocketThreshold*ctx->dynwork[best[2]].chunkSize)
+    return best[2];
+  return -1;
 }
 
 /*
 - This function chooses another thread to steal from, based on the threadId it is given.
+- returns -1 if no other thread has work left in its queue
 */
-int selectAnotherThread(int tid, int numThreads)
+int selectAnotherThread(vSched_context* ctx, int tid, int numThreads)
 {
-  return 0;
   int another_tid = -1;
-  #ifdef VERBOSE
-    printf("given threadID %d \t thd to steal from is %d \n", tid, another_tid);
+  if (numThreads < 2) return -1;
+  switch (ctx->victimSelection)
+  {
+  case VSCHED_VICTIM_ROUND_ROBIN: another_tid = select_victim_round_robin(ctx, tid, numThreads); break;
+  case VSCHED_VICTIM_MOST_WORK: another_tid = select_victim_most_work(ctx, tid, numThreads); break;
+  case VSCHED_VICTIM_HIERARCHICAL: another_tid = select_victim_hierarchical(ctx, tid, numThreads); break;
+  case VSCHED_VICTIM_RANDOM:
+  default: another_tid = select_victim_random(ctx, tid, numThreads); break;
+  }
+#ifdef VERBOSE
+  printf("given threadID %d \t thd to steal from is %d \n", tid, another_tid);
 #endif
-
-//for  now we choose the next tid
-//  another_tid = (tid + 1)%numThreads;
-  another_tid = (tid + 1)%numThreads ; // hardcode to 16 for now
-// Strategy 1: randomized stealing
-// Strategy 2: steal from thread with most elements in queue
   return another_tid;
 }
 
 /*
-This is the staggered method for mixed static/dynamic scheduling .
+  Steals the next chunk from the queue of thread t_x with a compare-and-swap.
+  Returns 0 if the queue of t_x is empty.
 */
-int loop_next_statdynstaggered(int *pstart, int *pend, int tid)
+static inline int vSched_steal(vSched_context* ctx, int *pstart, int *pend, int t_x)
 {
-#ifdef PROFILING
-  double time_loop_next = 0.0;
-  time_loop_next = - vSched_get_wtime();
-#endif
+  PossibleWork* q = &ctx->dynwork[t_x];
+  uint64_t old = __atomic_load_n(&q->work, __ATOMIC_ACQUIRE);
+  for (;;)
+  {
+    uint32_t next = vSched_next(old);
+    uint32_t limit = vSched_limit(old);
+    uint32_t newNext;
+    if (next >= limit) return 0;
+    newNext = (next + q->chunkSize < limit) ? next + q->chunkSize : limit;
+    if (__atomic_compare_exchange_n(&q->work, &old, vSched_pack(newNext, limit), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+    {
+      *pstart = (int)next;
+      *pend = (int)newNext;
+      if (newNext == limit) vSched_queue_drained(ctx);
+      return 1;
+    }
+  }
+}
 
+/*
+  Moves the upper half of the remaining work of thread t_x into the (empty)
+  queue of thread tid and hands out its first chunk, so the following chunks
+  are claimed locally instead of being stolen one at a time. Falls back to
+  stealing a single chunk when the victim has no more than a chunk left.
+  Returns 0 if the queue of t_x is empty.
+*/
+static inline int vSched_steal_half(vSched_context* ctx, int *pstart, int *pend, int tid, int t_x)
+{
+  PossibleWork* q = &ctx->dynwork[t_x];
+  PossibleWork* own = &ctx->dynwork[tid];
+  uint64_t old = __atomic_load_n(&q->work, __ATOMIC_ACQUIRE);
+  uint32_t next, limit, mid;
+  for (;;)
+  {
+    next = vSched_next(old);
+    limit = vSched_limit(old);
+    if (next >= limit) return 0;
+    if (limit - next <= (uint32_t)q->chunkSize) return vSched_steal(ctx, pstart, pend, t_x);
+    mid = next + (limit - next)/2;
+    // the victim keeps [next, mid), so its queue stays non-empty and count is unchanged
+    if (__atomic_compare_exchange_n(&q->work, &old, vSched_pack(next, mid), false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
+      break;
+  }
+  *pstart = (int)mid;
+  *pend = (mid + own->chunkSize < limit) ? (int)(mid + own->chunkSize) : (int)limit;
+  if (*pend < (int)limit)
+  {
+    __atomic_fetch_add(&ctx->count, 1, __ATOMIC_ACQ_REL);
+    __atomic_store_n(&own->work, vSched_pack(*pend, limit), __ATOMIC_RELEASE);
+  }
+  return 1;
+}
+
+/*
+This is the staggered method for mixed static/dynamic scheduling .
+*/
+static int next_statdynstaggered(vSched_context* ctx, int *pstart, int *pend, int tid)
+{
   int t_x  = -1;
-  if (count == 0) return 0;
-  pthread_mutex_lock(&(dynwork[tid]->qLock));
-  if(dynwork[tid]->nextChunk < dynwork[tid]->limit) // the thread still has work to be done in its own queue
+  if(vSched_claim_own(ctx, pstart, pend, tid)) // the thread still has work to be done in its own queue
   {
     #ifdef VERBOSE
-      printf("loop_next_sds(): thread %d . There is work in the local queue. nextChunk = %d \t limit = %d \n", tid, nextChunk, dynwork[tid]->limit);
+      printf("loop_next_sds(): thread %d . There is work in the local queue. pstart = %d \t pend = %d \n", tid, *pstart, *pend);
       #endif
-    *pstart = dynwork[tid]->nextChunk;
-    dynwork[tid]->nextChunk = dynwork[tid]->nextChunk + dynwork[tid]->chunkSize;
-    if(dynwork[tid]->nextChunk > dynwork[tid]->limit) dynwork[tid]->nextChunk = dynwork[tid]->limit;
-    *pend  = dynwork[tid]->nextChunk;
-    pthread_mutex_unlock(&(dynwork[tid]->qLock));
-    if(dynwork[tid]->nextChunk >= dynwork[tid]->limit) // this thread is done with its own queue
-    {
-      pthread_mutex_lock(&sched_lock);
-      count--;
-      pthread_mutex_unlock(&sched_lock);
-    }
-
-#ifdef PROFILING
-      time_loop_next += vSched_get_wtime();
-      printf("loop_next_sds(): thread %d \t time = %f  \n" , tid, time_loop_next);
-#endif
     return 1;
   }
   else // we steal from another thread
   {
 //    printf("[%d]: loop_next, steal: count=%d\n", tid,count);
-    pthread_mutex_unlock(&(dynwork[tid]->qLock));
-    if(count == 0) return 0;
-    t_x = selectAnotherThread(tid, threadCount);
-    if (t_x == -1) // we couldn't steal from another thread, as no other thread has work
+    int numThreads = __atomic_load_n(&ctx->numThreads, __ATOMIC_RELAXED);
+    while(__atomic_load_n(&ctx->count, __ATOMIC_ACQUIRE) > 0)
     {
-      return 0;
-    }
-    else // there is work from another thread to be stolen
-    {
-      if(count == 0) return 0;
-      pthread_mutex_lock(&(dynwork[t_x]->qLock));
+      t_x = selectAnotherThread(ctx, tid, numThreads);
+      if (t_x == -1) // we couldn't steal from another thread, as no other thread has work
+        return 0;
 #ifdef VERBOSE
       printf("loop_next_sds(): thread %d \t There is work from another thread to be stolen\n", tid);
 #endif
-      *pstart = dynwork[t_x]->nextChunk;
-      if (*pstart >= dynwork[t_x]->limit ) {      pthread_mutex_unlock(&(dynwork[t_x]->qLock)); return 0; }
-      dynwork[t_x]->nextChunk = dynwork[t_x]->nextChunk + dynwork[t_x]->chunkSize;
-      *pend = dynwork[t_x]->nextChunk;
-      if(*pend > dynwork[t_x]->limit) *pend = dynwork[t_x]->limit;
-      pthread_mutex_unlock(&(dynwork[t_x]->qLock));
-      return 1;
+      // the steal only fails if the victim was drained after it was selected, so try another one
+      if (ctx->stealHalf ? vSched_steal_half(ctx, pstart, pend, tid, t_x) : vSched_steal(ctx, pstart, pend, t_x))
+      {
+        ctx->dynwork[tid].steals++;
+        VSCHED_STATS_STEAL(1);
+        VSCHED_TRACE_STEAL(t_x);
+        return 1;
+      }
+      VSCHED_STATS_STEAL(0);
     }
+    return 0;
   } // end condition for stealing
 }
 
 /*
- get_constraint() :  used internally by vSched to determine the constraint of the scheduling
-  - returns 1 if constraint is satisfied and returns 0 if constraint is not satisfied
-  - returns -1 on error in calculation (this  should never occurs, unless of course the implementer of this function made a mistake in the calculation. The implementer must take care to test their functions before using it. Erroneous behavior may occur. )
-  - other parameters can be added here, but for simplicity we leave it without params
-  - the constraint_ value is set at the beginning of the threaded computation using the function setCDY
-  - note that this should be a fairly fast calculation, as this will be invoked many times.
+  Sums the statistics of all threads. Without RAJA_ENABLE_LWS_STATS nothing
+  is recorded and the sums are zero. Only exact while no loop is running.
 */
-
-int get_constraint()
+void vSched_get_stats(vSched_stats* stats)
 {
-  double rand_val = (double)rand()/(double)RAND_MAX;
+  memset(stats, 0, sizeof(vSched_stats));
+#if defined(RAJA_ENABLE_LWS_STATS)
+  pthread_mutex_lock(&init_lock);
+  for (vSched_stats_slot* slot = statsSlots; slot != NULL; slot = slot->next)
+    {
+      stats->chunks += slot->stats.chunks;
+      stats->stolen += slot->stats.stolen;
+      stats->failedSteals += slot->stats.failedSteals;
+      stats->dequeueTime += slot->stats.dequeueTime;
+      stats->bodyTime += slot->stats.bodyTime;
+    }
+  pthread_mutex_unlock(&init_lock);
+#endif
+}
 
-  if(rand_val < 0.0 || rand_val > 1.0)
-    return -1;
-  #ifdef VERBOSE
-    printf("constraint_ =  %f \t rand= %f \n", constraint_, rand_val);
+void vSched_reset_stats(void)
+{
+#if defined(RAJA_ENABLE_LWS_STATS)
+  pthread_mutex_lock(&init_lock);
+  for (vSched_stats_slot* slot = statsSlots; slot != NULL; slot = slot->next)
+    memset(&slot->stats, 0, sizeof(vSched_stats));
+  pthread_mutex_unlock(&init_lock);
 #endif
-// below is a simple condition  used for constraint. More complicated functions can be used below, to implementor's liking */
-  if(rand_val < constraint_)
-    return 1;
-  else
-    return 0;
 }
 
+void vSched_stats_add_body_time(double seconds)
+{
+#if defined(RAJA_ENABLE_LWS_STATS)
+  vSched_thread_stats()->bodyTime += seconds;
+#else
+  (void)seconds;
+#endif
+}
 
-// TODO :  figure this out for both threaded and non-threaded regions
+/*
+  Number of successful steals in the last statdynstaggered loop run with ctx.
+  Only meaningful once every thread is done with the loop.
+*/
+int vSched_context_steals(vSched_context* ctx)
+{
+  int steals = 0;
+  for (int t = 0; t < ctx->numThreads; t++)
+    steals += ctx->dynwork[t].steals;
+  return steals;
+}
 
-double vSched_get_wtime(void)
+/*
+  The thread that the chunk last handed to the calling thread was stolen
+  from, or -1 if it was not stolen (or nothing was stolen since the last
+  call); resets it to -1. Only recorded with RAJA_ENABLE_LWS_TRACE.
+*/
+int vSched_take_stolen_from(void)
 {
-  struct rusage ruse;
-// getrusage(RUSAGE_SELF, &ruse);
-// see documentation , need to use rusage thread for proper timing
-//  if(inThreadedRegion)
-#ifdef RUSAGE_THREAD
-  getrusage(RUSAGE_THREAD, &ruse);
+#if defined(RAJA_ENABLE_LWS_TRACE)
+  int victim = stolenFrom;
+  stolenFrom = -1;
+  return victim;
 #else
-  getrusage(RUSAGE_CHILDREN, &ruse);
+  return -1;
 #endif
+}
 
-#ifdef VERBOSE
-    printf("vSched_get_wtime(): \n") ;
+VSCHED_DEFINE_LOOP_NEXT(statdynstaggered)
+
+int loop_start_statdynstaggered(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads)
+{
+  return loop_start_statdynstaggered_ctx(&defaultContext, loopBegin, _loopEnd, pstart, pend, threadID, numThreads);
+}
+
+int loop_next_statdynstaggered(int *pstart, int *pend, int tid)
+{
+  return loop_next_statdynstaggered_ctx(&defaultContext, pstart, pend, tid);
+}
+
+// TODO :  figure this out for both threaded and non-threaded regions
+
+double vSched_secondsPerTick = 0.0;
+uint64_t vSched_tickBase = 0;
+int vSched_cycleCounter = 0;
+static pthread_once_t timerOnce = PTHREAD_ONCE_INIT;
+
+/*
+  Uses the cycle counter if its rate is constant, and measures that rate
+  against CLOCK_MONOTONIC over a couple of milliseconds.
+*/
+static void vSched_timer_calibrate(void)
+{
+  double secondsPerTick = 1e-9;
+#if defined(__x86_64__) || defined(__i386__)
+  unsigned int eax, ebx, ecx, edx;
+  // invariant TSC: ticks at a constant rate in every P-, C- and T-state
+  if (__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) && (edx & (1u << 8)))
+    {
+      uint64_t ns0 = vSched_monotonic_ns(), ns1;
+      uint64_t t0 = __rdtsc(), t1;
+      do
+	{
+	  ns1 = vSched_monotonic_ns();
+	  t1 = __rdtsc();
+	}
+      while (ns1 - ns0 < 2000000);
+      if (t1 > t0)
+	{
+	  secondsPerTick = (double)(ns1 - ns0)*1e-9/(double)(t1 - t0);
+	  vSched_cycleCounter = 1;
+	}
+    }
+#elif defined(__aarch64__)
+  uint64_t freq;
+  __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(freq));
+  if (freq > 0)
+    {
+      secondsPerTick = 1.0/(double)freq;
+      vSched_cycleCounter = 1;
+    }
 #endif
+  vSched_tickBase = vSched_ticks();
+  __atomic_store(&vSched_secondsPerTick, &secondsPerTick, __ATOMIC_RELEASE);
+}
 
-  return( (double)(ruse.ru_utime.tv_sec+ruse.ru_utime.tv_usec / 1000000.0) );
+void vSched_timer_init(void)
+{
+  pthread_once(&timerOnce, vSched_timer_calibrate);
 }
 
+/*
+  Wall-clock time in seconds. It used to be the user CPU time of the thread
+  from getrusage(), which costs a system call and misses time the thread
+  spends descheduled.
+*/
+double vSched_get_wtime(void)
+{
+  return vSched_now();
+}
 
 double nont_vSched_get_wtime(void)
 {
-  struct rusage ruse;
-getrusage(RUSAGE_SELF, &ruse);
-// see documentation , need to use rusage thread for proper timing
-
-#ifdef VERBOSE
-    printf("vSched_get_wtime(): \n") ;
-#endif
-  return( (double)(ruse.ru_utime.tv_sec+ruse.ru_utime.tv_usec / 1000000.0) );
+  return vSched_now();
 }
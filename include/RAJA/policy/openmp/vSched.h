@@ -1,10 +1,83 @@
+#ifndef VSCHED_H
+#define VSCHED_H
 
+#ifdef __cplusplus
+extern "C" {
+#endif
 
+/* victim selection strategies for stealing in statdynstaggered, see setStealStrategy() */
+enum {
+  VSCHED_VICTIM_RANDOM = 0,      /* probe randomly chosen threads, with a per-thread RNG */
+  VSCHED_VICTIM_ROUND_ROBIN = 1, /* probe the other threads in order, after the last victim */
+  VSCHED_VICTIM_MOST_WORK = 2,   /* pick the thread with the most remaining work */
+  VSCHED_VICTIM_HIERARCHICAL = 3 /* the most work in the same cache group, then the same socket, then
+                                    other sockets (see setCrossSocketThreshold and vSched_set_topology) */
+};
+
+/*
+  The state of one scheduled loop. Each loop that runs at the same time as
+  another one (nested, or from another application thread) needs its own
+  context; the functions without a context argument use a shared default one.
+*/
+typedef struct vSched_context vSched_context;
+
+/*
+  Scheduler statistics, summed over all threads. They are only recorded when
+  vSched is built with RAJA_ENABLE_LWS_STATS.
+*/
+typedef struct vSched_stats
+{
+  unsigned long long chunks;       /* non-empty chunks handed out by loop_next_*() */
+  unsigned long long stolen;       /* chunks taken from another thread's queue */
+  unsigned long long failedSteals; /* steals that found the victim's queue empty */
+  double dequeueTime;              /* seconds spent in loop_next_*() */
+  double bodyTime;                 /* seconds spent in loop bodies, see vSched_stats_add_body_time() */
+} vSched_stats;
+
+/*
+  What the constraint of the cdy strategy is evaluated on: the calling
+  thread, the progress of the dynamic part of the loop, the seconds since the
+  loop started, a uniform random number in [0, 1) drawn for this evaluation
+  from the thread's own counter-based generator, and the constraint value
+  given to setCDY().
+*/
+typedef struct vSched_cdy_state
+{
+  int tid;
+  int numThreads;
+  int dynBegin;     /* first iteration of the dynamic part */
+  int next;         /* next iteration to hand out */
+  int loopEnd;
+  double elapsed;
+  double random;
+  double constraint;
+} vSched_cdy_state;
+
+/*
+  Decides whether a thread may take a chunk of a cdy loop: nonzero lets it,
+  0 makes it retry (with an empty chunk). It runs on every dequeue of every
+  thread, concurrently, so it must be cheap and thread-safe, and it must
+  eventually let some thread through or the loop does not finish.
+*/
+typedef int (*vSched_cdy_constraint)(const vSched_cdy_state* state, void* arg);
+
+extern void vSched_get_stats(vSched_stats* stats);
+extern void vSched_reset_stats(void);
+extern void vSched_stats_add_body_time(double seconds);
+
+extern vSched_context* vSched_context_acquire(int numThreads);
+extern void vSched_context_release(vSched_context* ctx);
+extern void vSched_context_set_static_fraction(vSched_context* ctx, float f, int _chunkSize);
+extern void vSched_context_set_cdy_constraint(vSched_context* ctx, vSched_cdy_constraint constraint, void* arg);
+extern int vSched_context_steals(vSched_context* ctx);
+/* see vSched_take_stolen_from() in vSched.c; -1 without RAJA_ENABLE_LWS_TRACE */
+extern int vSched_take_stolen_from(void);
 
 extern void vSched_init(int);
 extern void vSched_finalize(int);
-extern double vSched_get_wtime();
-extern double nont_vSched_get_wtime();
+/* wall-clock seconds from a calibrated cycle counter, see vSched_internal.h */
+extern double vSched_get_wtime(void);
+extern double nont_vSched_get_wtime(void);
 
 
 // TODO: figure out whether below should be extern'd
@@ -13,16 +86,55 @@ extern int loop_next_static(int *pstart, int *pend);
 
 extern void setStaticFraction(float f, int _chunkSize);
 extern void setCDY(float f, double constraint, int _chunkSize);
+/* NULL goes back to the default constraint, random < constraint */
+extern void setCDYConstraint(vSched_cdy_constraint constraint, void* arg);
+extern void setStealStrategy(int victimSelection, int stealHalf);
+extern void setCrossSocketThreshold(int minChunks);
+
+/*
+  Replaces the CPU topology read from /sys/devices/system/cpu with a
+  simulated one, for testing: one "socket:group" pair per CPU, separated by
+  spaces, e.g. "0:0 0:0 0:1 0:1 1:2 1:2 1:3 1:3". With a simulated topology,
+  thread t is taken to run on CPU t modulo the number of CPUs. NULL goes back
+  to the real topology. Returns 0, or -1 if the description can't be parsed.
+  The VSCHED_TOPOLOGY environment variable is read the same way. Only call
+  it while no loop is running.
+*/
+extern int vSched_set_topology(const char* description);
 
 extern int loop_start_static_fraction(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
 extern int loop_next_static_fraction(int *pstart, int *pend);
+extern int loop_start_static_fraction_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
+extern int loop_next_static_fraction_ctx(vSched_context* ctx, int *pstart, int *pend, int tid);
 
-extern int loop_start_cdy(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
- extern int loop_next_cdy(int *pstart, int *pend);
-// extern int loop_next_cdy(int *pstart, int *pend, double constraint_val);
+extern int loop_start_guided(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
+extern int loop_next_guided(int *pstart, int *pend, int tid);
+extern int loop_start_guided_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
+extern int loop_next_guided_ctx(vSched_context* ctx, int *pstart, int *pend, int tid);
+
+extern int loop_start_factoring(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
+extern int loop_next_factoring(int *pstart, int *pend, int tid);
+extern int loop_start_factoring_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
+extern int loop_next_factoring_ctx(vSched_context* ctx, int *pstart, int *pend, int tid);
+
+extern int loop_start_trapezoid(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
+extern int loop_next_trapezoid(int *pstart, int *pend, int tid);
+extern int loop_start_trapezoid_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
+extern int loop_next_trapezoid_ctx(vSched_context* ctx, int *pstart, int *pend, int tid);
 
 extern int loop_start_cdy(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
 extern int loop_next_cdy(int *pstart, int *pend, int tid);
+extern int loop_start_cdy_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
+extern int loop_next_cdy_ctx(vSched_context* ctx, int *pstart, int *pend, int tid);
 
 extern int loop_start_statdynstaggered(int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
 extern int loop_next_statdynstaggered(int *pstart, int *pend, int tid);
+extern int loop_start_statdynstaggered_ctx(vSched_context* ctx, int loopBegin, int _loopEnd, int *pstart, int *pend, int threadID, int numThreads);
+extern int loop_next_statdynstaggered_ctx(vSched_context* ctx, int *pstart, int *pend, int tid);
+extern int loop_start_statdynstaggered_range_ctx(vSched_context* ctx, int rangeBegin, int rangeEnd, int *pstart, int *pend, int threadID, int numThreads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
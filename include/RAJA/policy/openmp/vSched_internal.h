@@ -0,0 +1,198 @@
+#ifndef VSCHED_INTERNAL_H
+#define VSCHED_INTERNAL_H
+
+/*
+  Data structures of the vSched library, and the operations on them that are
+  on the per-chunk path. They are in a header so that callers can inline the
+  common case (a thread claiming a chunk from its own queue); everything else
+  goes through the functions in vSched.h.
+*/
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "vSched.h"
+
+#define VSCHED_CACHE_LINE 64
+
+/*
+  The dynamic work of one thread. The next chunk to hand out and the limit of
+  the queue are packed into the single word `work` (next in the low 32 bits,
+  limit in the high 32 bits), so the owner claims a chunk with one atomic
+  fetch-add, a thief steals with one compare-and-swap, and both always see a
+  consistent (next, limit) pair. Each queue is padded to its own cache line.
+  rngState, lastVictim and steals are only used by the owner when it steals,
+  and draws when it evaluates a cdy constraint.
+  cacheGroup, socket and sharedLoop are set by the owner when the loop
+  starts.
+*/
+typedef struct PossibleWork  // coem up with a better name
+{
+  uint64_t work;
+  uint64_t rngState;
+  uint64_t draws; // random numbers drawn by the owner for cdy, the counter of its generator
+  int chunkSize;
+  int lastVictim;
+  int steals; // successful steals by the owner in the current loop
+  int cacheGroup; // where the owner runs, for VSCHED_VICTIM_HIERARCHICAL
+  int socket;
+  int sharedLoop; // the last loop on the shared counter the owner started
+  char pad[VSCHED_CACHE_LINE - 3*sizeof(uint64_t) - 6*sizeof(int)];
+} PossibleWork ;
+
+/*
+  All the state of one scheduled loop: the schedule parameters, the per-thread
+  queues and the completion state. Loops that use different contexts can run
+  at the same time, nested or from different application threads.
+*/
+struct vSched_context
+{
+  // schedule parameters, copied from the defaults when the context is acquired
+  float f_s;
+  float f_d;
+  double constraint_;
+  int chunkSize;
+  int victimSelection; // how a thief picks the thread to steal from
+  int stealHalf; // if set, a thief moves half of the victim's remaining work into its own queue
+  int crossSocketThreshold; // chunks a victim on another socket must have left to be stolen from, -1 for never
+
+  // statdynstaggered state
+  PossibleWork* dynwork;
+  int threadCount; // number of per-thread queues allocated
+  int numThreads; // number of threads in the loop being scheduled
+  int count; // number of per-thread queues that still have dynamic work, updated atomically
+
+  // state of the strategies that hand out the dynamic part of the loop from
+  // one shared counter (static_fraction, cdy, guided, factoring, trapezoid)
+  pthread_mutex_t sched_lock;
+  int nextChunk;
+  int loopEnd;
+  int isLoopStarted; // 0 between loops, 1 while the counter is set up, 2 while a loop runs
+  int dynBegin; // first iteration of the dynamic part
+  int nextChunkIndex; // index of the next chunk, for factoring and trapezoid
+  int sharedLoop; // number of the loop the counter was last set up for
+  int finished; // threads that have run out of chunks in the running loop
+
+  int inUse; // set while a pooled context is handed out
+  int pooled;
+
+  // cdy constraint, copied from the defaults when the context is acquired
+  vSched_cdy_constraint cdyConstraint; // NULL for random < constraint_
+  void* cdyConstraintArg;
+  double loopStartTime; // when the shared counter was set up
+};
+
+/*
+  Timing for the scheduler: reading the time costs a few nanoseconds, so
+  strategies and statistics can take it per chunk. Ticks come from the
+  processor's cycle counter (an invariant TSC on x86, the virtual counter on
+  AArch64), calibrated against CLOCK_MONOTONIC the first time the time is
+  read, or from CLOCK_MONOTONIC itself if there is no usable counter.
+*/
+#ifdef __cplusplus
+extern "C" {
+#endif
+extern double vSched_secondsPerTick; /* 0 until vSched_timer_init() ran */
+extern uint64_t vSched_tickBase;
+extern int vSched_cycleCounter; /* 1 if ticks come from the cycle counter */
+extern void vSched_timer_init(void);
+#ifdef __cplusplus
+}
+#endif
+
+static inline uint64_t vSched_monotonic_ns(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec*1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint64_t vSched_ticks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+  if (vSched_cycleCounter) return __rdtsc();
+#elif defined(__aarch64__)
+  if (vSched_cycleCounter)
+    {
+      uint64_t t;
+      __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(t));
+      return t;
+    }
+#endif
+  return vSched_monotonic_ns();
+}
+
+/*
+  Wall-clock seconds since the timer was calibrated.
+*/
+static inline double vSched_now(void)
+{
+  double secondsPerTick;
+  __atomic_load(&vSched_secondsPerTick, &secondsPerTick, __ATOMIC_ACQUIRE);
+  if (secondsPerTick == 0.0)
+    {
+      vSched_timer_init();
+      __atomic_load(&vSched_secondsPerTick, &secondsPerTick, __ATOMIC_ACQUIRE);
+    }
+  return (double)(vSched_ticks() - vSched_tickBase)*secondsPerTick;
+}
+
+/*
+  Uniform in [0, 1): the splitmix64 finalizer of key, for random numbers that
+  are a fixed function of a seed, a thread and a counter rather than the
+  state of a generator.
+*/
+static inline double vSched_uniform(uint64_t key)
+{
+  uint64_t x = key + 0x9E3779B97F4A7C15ULL;
+  x = (x ^ (x >> 30))*0xBF58476D1CE4E5B9ULL;
+  x = (x ^ (x >> 27))*0x94D049BB133111EBULL;
+  x ^= x >> 31;
+  return (double)(x >> 11)*(1.0/9007199254740992.0);
+}
+
+static inline uint64_t vSched_pack(uint32_t next, uint32_t limit)
+{
+  return ((uint64_t)limit << 32) | (uint64_t)next;
+}
+
+static inline uint32_t vSched_next(uint64_t work) { return (uint32_t)work; }
+
+static inline uint32_t vSched_limit(uint64_t work) { return (uint32_t)(work >> 32); }
+
+/*
+  Called by the one thread that sees a queue go from non-empty to empty.
+*/
+static inline void vSched_queue_drained(vSched_context* ctx)
+{
+  __atomic_fetch_sub(&ctx->count, 1, __ATOMIC_ACQ_REL);
+}
+
+/*
+  Claims the next chunk of the calling thread's own queue with a fetch-add.
+  Returns 0 if the queue is empty.
+*/
+static inline int vSched_claim_own(vSched_context* ctx, int *pstart, int *pend, int tid)
+{
+  PossibleWork* q = &ctx->dynwork[tid];
+  uint64_t old = __atomic_load_n(&q->work, __ATOMIC_ACQUIRE);
+  uint32_t next, limit;
+  // don't fetch-add on an empty queue, so next can't creep up into the limit bits
+  if (vSched_next(old) >= vSched_limit(old)) return 0;
+  old = __atomic_fetch_add(&q->work, (uint64_t)q->chunkSize, __ATOMIC_ACQ_REL);
+  next = vSched_next(old);
+  limit = vSched_limit(old);
+  if (next >= limit) return 0; // a thief took the rest of the queue after we looked at it
+  *pstart = (int)next;
+  *pend = (next + q->chunkSize < limit) ? (int)(next + q->chunkSize) : (int)limit;
+  if (*pend == (int)limit) vSched_queue_drained(ctx);
+  return 1;
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include "RAJA/internal/MemUtils_CPU.hpp"
 
 #include "RAJA/pattern/detail/reduce.hpp"
+#include "RAJA/pattern/detail/reduce_array.hpp"
 #include "RAJA/pattern/reduce.hpp"
 
 #include "RAJA/policy/sequential/policy.hpp"
@@ -62,6 +63,7 @@ public:
 } /* detail */
 
 RAJA_DECLARE_ALL_REDUCERS(seq_reduce, detail::ReduceSeq)
+RAJA_DECLARE_ARRAY_REDUCER(seq_reduce, reduce::detail::ReduceArrayShared)
 
 }  // closing brace for RAJA namespace
 
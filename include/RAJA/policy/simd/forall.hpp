@@ -9,8 +9,8 @@
  *          These methods should work on any platform. They make no
  *          asumptions about data alignment.
  *
- *          Note: Reduction operations should not be used with simd
- *          policies. Limited support.
+ *          Note: Reduction operations should not be used with simd_exec;
+ *          use simd_lanes_exec, which gives each lane its own reducers.
  *
  *
  ******************************************************************************
@@ -39,10 +39,14 @@
 #include <iterator>
 #include <type_traits>
 
+#include "camp/camp.hpp"
+
 #include "RAJA/util/types.hpp"
 
 #include "RAJA/internal/fault_tolerance.hpp"
 
+#include "RAJA/pattern/forall.hpp"
+
 #include "RAJA/policy/simd/policy.hpp"
 
 namespace RAJA
@@ -67,6 +71,49 @@ RAJA_INLINE void forall_impl(const simd_exec &,
   }
 }
 
+namespace detail
+{
+
+template <camp::idx_t... Lane, typename Iterator, typename Func>
+RAJA_INLINE void forall_lanes(camp::idx_seq<Lane...>,
+                              Iterator begin,
+                              Iterator end,
+                              Func &&loop_body)
+{
+  using RAJA::internal::thread_privatize;
+  using privatizer = decltype(thread_privatize(loop_body));
+  auto distance = std::distance(begin, end);
+  using distance_type = decltype(distance);
+  constexpr distance_type lanes = sizeof...(Lane);
+
+  // a body per lane: the accumulators of their reducers are independent, so
+  // the unrolled calls below carry no dependency from one to the next, and
+  // they combine into the reducers the body was made with when they go out
+  // of scope
+  privatizer lane[lanes] = {((void)Lane, thread_privatize(loop_body))...};
+
+  distance_type i = 0;
+  for (; i + lanes <= distance; i += lanes) {
+    camp::sink((lane[Lane].get_priv()(*(begin + i + Lane)), 0)...);
+  }
+  for (; i < distance; ++i) {
+    lane[0].get_priv()(*(begin + i));
+  }
+}
+
+}  // closing brace for detail namespace
+
+template <int Lanes, typename Iterable, typename Func>
+RAJA_INLINE void forall_impl(const simd_lanes_exec<Lanes> &,
+                             Iterable &&iter,
+                             Func &&loop_body)
+{
+  detail::forall_lanes(camp::make_idx_seq_t<Lanes>{},
+                       std::begin(iter),
+                       std::end(iter),
+                       std::forward<Func>(loop_body));
+}
+
 }  // closing brace for simd namespace
 
 }  // closing brace for policy namespace
@@ -52,11 +52,26 @@ struct simd_exec : make_policy_pattern_launch_platform_t<Policy::sequential,
                                                          Platform::host> {
 };
 
+///
+/// For loops with reducers: runs the iterations on Lanes copies of the loop
+/// body in turn, so each lane has reducer copies of its own and the lanes
+/// can be vectorized together.
+///
+template <int Lanes = 8>
+struct simd_lanes_exec
+    : make_policy_pattern_launch_platform_t<Policy::sequential,
+                                            Pattern::forall,
+                                            Launch::undefined,
+                                            Platform::host> {
+  static_assert(Lanes > 0, "simd_lanes_exec needs at least one lane");
+};
+
 }  // end of namespace simd
 
 }  // end of namespace policy
 
 using policy::simd::simd_exec;
+using policy::simd::simd_lanes_exec;
 
 }  // end of namespace RAJA
 
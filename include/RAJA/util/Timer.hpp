@@ -250,6 +250,128 @@ private:
 using TimerBase = ClockTimer;
 }  // closing brace for RAJA namespace
 
+#elif defined(RAJA_USE_CYCLE)
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#endif
+
+namespace RAJA
+{
+
+/*!
+ ******************************************************************************
+ *
+ * \brief  Timer class that reads the processor's cycle counter (an invariant
+ *         TSC on x86, the virtual counter on AArch64), so start() and stop()
+ *         cost a few nanoseconds. The counter rate is calibrated against
+ *         std::chrono::steady_clock once per program; without a usable
+ *         counter the timer counts steady_clock nanoseconds instead.
+ *
+ *         Generates elapsed time in seconds.
+ *
+ ******************************************************************************
+ */
+class CycleTimer
+{
+public:
+  using ElapsedType = double;
+
+private:
+  using TimeType = std::uint64_t;
+  using ClockType = std::chrono::steady_clock;
+
+public:
+  CycleTimer() : tstart(ticks()), tstop(tstart), telapsed(0) {}
+
+  void start() { tstart = ticks(); }
+  void stop()
+  {
+    tstop = ticks();
+    telapsed += tstop - tstart;
+  }
+
+  ElapsedType elapsed() const
+  {
+    return static_cast<ElapsedType>(telapsed) * seconds_per_tick();
+  }
+
+  void reset() { telapsed = 0; }
+
+private:
+  TimeType tstart;
+  TimeType tstop;
+  TimeType telapsed;
+
+  static TimeType clock_ticks()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               ClockType::now().time_since_epoch())
+        .count();
+  }
+
+  static bool has_counter()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    static const bool invariant_tsc = []() {
+      unsigned int eax, ebx, ecx, edx;
+      return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx)
+             && (edx & (1u << 8));
+    }();
+    return invariant_tsc;
+#elif defined(__aarch64__)
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  static TimeType ticks()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    if (has_counter()) return __rdtsc();
+#elif defined(__aarch64__)
+    TimeType t;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(t));
+    return t;
+#endif
+    return clock_ticks();
+  }
+
+  static ElapsedType seconds_per_tick()
+  {
+    static const ElapsedType seconds = calibrate();
+    return seconds;
+  }
+
+  static ElapsedType calibrate()
+  {
+    if (!has_counter()) return 1e-9;
+#if defined(__aarch64__)
+    TimeType freq;
+    __asm__ __volatile__("mrs %0, cntfrq_el0" : "=r"(freq));
+    return 1.0 / static_cast<ElapsedType>(freq);
+#else
+    const TimeType ns0 = clock_ticks();
+    const TimeType t0 = ticks();
+    TimeType ns1, t1;
+    do {
+      ns1 = clock_ticks();
+      t1 = ticks();
+    } while (ns1 - ns0 < 2000000);
+    return static_cast<ElapsedType>(ns1 - ns0) * 1e-9
+           / static_cast<ElapsedType>(t1 - t0);
+#endif
+  }
+};
+
+using TimerBase = CycleTimer;
+}  // closing brace for RAJA namespace
+
 #else
 
 #error RAJA_TIMER is undefined!
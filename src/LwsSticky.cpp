@@ -0,0 +1,135 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Implementation file for the sticky lws schedules.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP)
+
+#include <map>
+#include <mutex>
+
+#include "RAJA/policy/openmp/lws_sticky.hpp"
+
+namespace RAJA
+{
+namespace lws
+{
+
+namespace
+{
+
+std::mutex& sticky_mutex()
+{
+  static std::mutex m;
+  return m;
+}
+
+// std::map never moves its elements, so schedules handed out stay valid
+// until reset_sticky_schedules()
+std::map<tuning_key, detail::sticky_schedule>& sticky_table()
+{
+  static std::map<tuning_key, detail::sticky_schedule> table;
+  return table;
+}
+
+}  // closing brace for anonymous namespace
+
+sticky_info get_sticky_info(const tuning_key& key)
+{
+  std::lock_guard<std::mutex> lock(sticky_mutex());
+  auto& table = sticky_table();
+  auto it = table.find(key);
+  if (it == table.end()) {
+    return sticky_info{0, 0, false};
+  }
+  return sticky_info{it->second.recordings,
+                     it->second.replays,
+                     it->second.recorded};
+}
+
+void reset_sticky_schedules()
+{
+  std::lock_guard<std::mutex> lock(sticky_mutex());
+  auto& table = sticky_table();
+  for (auto it = table.begin(); it != table.end();) {
+    // a schedule in use is only forgotten for the runs after its loop,
+    // when the loop releases it
+    if (it->second.in_use) {
+      it->second.reset_pending = true;
+      ++it;
+    } else {
+      it = table.erase(it);
+    }
+  }
+}
+
+namespace detail
+{
+
+sticky_schedule* sticky_acquire(const tuning_key& key)
+{
+  std::lock_guard<std::mutex> lock(sticky_mutex());
+  sticky_schedule& schedule = sticky_table()[key];
+  if (schedule.in_use) {
+    return nullptr;
+  }
+  schedule.in_use = true;
+  return &schedule;
+}
+
+void sticky_release(sticky_schedule* schedule,
+                    sticky_outcome outcome,
+                    int num_threads)
+{
+  std::lock_guard<std::mutex> lock(sticky_mutex());
+  switch (outcome) {
+    case sticky_outcome::none:
+      break;
+    case sticky_outcome::recorded:
+      ++schedule->recordings;
+      schedule->num_threads = num_threads;
+      schedule->recorded = true;
+      break;
+    case sticky_outcome::replayed:
+      ++schedule->replays;
+      break;
+    case sticky_outcome::imbalanced:
+      ++schedule->replays;
+      schedule->recorded = false;
+      break;
+  }
+  if (schedule->reset_pending) {
+    schedule->recorded = false;
+    schedule->reset_pending = false;
+  }
+  schedule->in_use = false;
+}
+
+}  // closing brace for detail namespace
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for if defined(RAJA_ENABLE_OPENMP)
@@ -0,0 +1,234 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Implementation file for the thread pool of the lws std::thread
+ *          policies.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_LWS_THREADS)
+
+#include <climits>
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "RAJA/policy/lws/thread_pool.hpp"
+
+namespace RAJA
+{
+namespace lws
+{
+namespace detail
+{
+
+namespace
+{
+
+// polls of the generation before a worker goes to sleep
+const int spin_polls = 4096;
+
+// the pool thread number of a worker, set once when it starts
+thread_local int this_thread_num = 0;
+
+#if defined(__linux__)
+
+// std::atomic<int> is a plain int on Linux, so the kernel can wait on it
+void park(std::atomic<int>& word, int value)
+{
+  syscall(SYS_futex,
+          reinterpret_cast<int*>(&word),
+          FUTEX_WAIT_PRIVATE,
+          value,
+          nullptr,
+          nullptr,
+          0);
+}
+
+void wake_all(std::atomic<int>& word)
+{
+  syscall(SYS_futex,
+          reinterpret_cast<int*>(&word),
+          FUTEX_WAKE_PRIVATE,
+          INT_MAX,
+          nullptr,
+          nullptr,
+          0);
+}
+
+std::vector<int> allowed_cpus()
+{
+  std::vector<int> cpus;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+  return cpus;
+}
+
+void pin_to(int cpu)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  sched_setaffinity(0, sizeof(set), &set);
+}
+
+#else
+
+void park(std::atomic<int>&, int) { std::this_thread::yield(); }
+
+void wake_all(std::atomic<int>&) {}
+
+std::vector<int> allowed_cpus() { return std::vector<int>(); }
+
+void pin_to(int) {}
+
+#endif
+
+int pool_size(int numCpus)
+{
+  const char* env = std::getenv("RAJA_LWS_NUM_THREADS");
+  if (env != nullptr) {
+    int n = std::atoi(env);
+    if (n > 0) {
+      return n;
+    }
+  }
+  if (numCpus > 0) {
+    return numCpus;
+  }
+  int n = static_cast<int>(std::thread::hardware_concurrency());
+  return (n > 0) ? n : 1;
+}
+
+}  // closing brace for anonymous namespace
+
+thread_pool& thread_pool::instance()
+{
+  static thread_pool pool;
+  return pool;
+}
+
+int thread_pool::thread_num() { return this_thread_num; }
+
+thread_pool::thread_pool()
+{
+  std::vector<int> cpus = allowed_cpus();
+  const int numThreads = pool_size(static_cast<int>(cpus.size()));
+  // the thread running a job stays where it is; workers take the other CPUs
+  const bool pin =
+      !cpus.empty() && numThreads <= static_cast<int>(cpus.size());
+
+  m_workers.reserve(numThreads - 1);
+  for (int t = 1; t < numThreads; ++t) {
+    m_workers.emplace_back(&thread_pool::worker, this, t, pin ? cpus[t] : -1);
+  }
+}
+
+thread_pool::~thread_pool()
+{
+  m_stop.store(true, std::memory_order_relaxed);
+  m_generation.value.fetch_add(1);
+  wake_all(m_generation.value);
+  for (auto& w : m_workers) {
+    w.join();
+  }
+}
+
+void thread_pool::run_job(job_fn fn, void* job)
+{
+  bool idle = false;
+  if (m_workers.empty()
+      || !m_busy.compare_exchange_strong(idle,
+                                         true,
+                                         std::memory_order_acquire,
+                                         std::memory_order_relaxed)) {
+    fn(job, 0, 1);
+    return;
+  }
+
+  m_fn = fn;
+  m_job = job;
+  m_remaining.value.store(static_cast<int>(m_workers.size()),
+                          std::memory_order_relaxed);
+  // sequentially consistent, so that either a worker about to sleep sees
+  // the new generation or this thread sees the sleeper
+  m_generation.value.fetch_add(1);
+  if (m_sleepers.value.load() > 0) {
+    wake_all(m_generation.value);
+  }
+
+  fn(job, 0, size());
+
+  while (m_remaining.value.load(std::memory_order_acquire) > 0) {
+    std::this_thread::yield();
+  }
+  m_busy.store(false, std::memory_order_release);
+}
+
+void thread_pool::worker(int threadNum, int cpu)
+{
+  this_thread_num = threadNum;
+  if (cpu >= 0) {
+    pin_to(cpu);
+  }
+
+  // no job has started before the pool is constructed
+  int seen = 0;
+  for (;;) {
+    int generation = seen;
+    for (int poll = 0; poll < spin_polls && generation == seen; ++poll) {
+      generation = m_generation.value.load(std::memory_order_acquire);
+    }
+    while (generation == seen) {
+      m_sleepers.value.fetch_add(1);
+      park(m_generation.value, seen);
+      m_sleepers.value.fetch_sub(1, std::memory_order_relaxed);
+      generation = m_generation.value.load(std::memory_order_acquire);
+    }
+    seen = generation;
+
+    if (m_stop.load(std::memory_order_relaxed)) {
+      return;
+    }
+    m_fn(m_job, threadNum, size());
+    m_remaining.value.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+}  // closing brace for detail namespace
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for if defined(RAJA_ENABLE_LWS_THREADS)
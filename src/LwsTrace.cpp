@@ -0,0 +1,208 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Implementation file for the lws loop trace.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP) || defined(RAJA_ENABLE_LWS_THREADS)
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include <mutex>
+#include <ostream>
+
+#include "RAJA/policy/openmp/lws_trace.hpp"
+
+namespace RAJA
+{
+namespace lws
+{
+
+namespace
+{
+
+std::atomic<bool> trace_on{true};
+
+std::mutex& trace_mutex()
+{
+  static std::mutex m;
+  return m;
+}
+
+// buffers are kept after their thread exits, so its chunks are still
+// written; they are linked in front, so the list is newest first
+detail::trace_buffer* trace_buffers = nullptr;
+int trace_tracks = 0;
+
+template <typename F>
+void for_each_trace_event(F&& f)
+{
+  for (detail::trace_buffer* b = trace_buffers; b != nullptr; b = b->next) {
+    const long n = b->size.load(std::memory_order_acquire);
+    for (long e = 0; e < n; ++e) {
+      f(b->track, b->events[e]);
+    }
+  }
+}
+
+}  // closing brace for anonymous namespace
+
+void set_tracing(bool on) { trace_on.store(on, std::memory_order_relaxed); }
+
+bool tracing() { return trace_on.load(std::memory_order_relaxed); }
+
+std::vector<trace_event> get_trace()
+{
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  std::vector<trace_event> events;
+  for_each_trace_event(
+      [&](int, const trace_event& e) { events.push_back(e); });
+  return events;
+}
+
+long trace_dropped()
+{
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  long dropped = 0;
+  for (detail::trace_buffer* b = trace_buffers; b != nullptr; b = b->next) {
+    dropped += b->dropped;
+  }
+  return dropped;
+}
+
+void clear_trace()
+{
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  for (detail::trace_buffer* b = trace_buffers; b != nullptr; b = b->next) {
+    b->size.store(0, std::memory_order_relaxed);
+    b->dropped = 0;
+  }
+}
+
+void write_trace(std::ostream& out)
+{
+  std::lock_guard<std::mutex> lock(trace_mutex());
+  double origin = std::numeric_limits<double>::infinity();
+  for_each_trace_event([&](int, const trace_event& e) {
+    origin = std::min(origin, e.start);
+  });
+
+  const std::ios::fmtflags flags = out.flags();
+  const std::streamsize precision = out.precision();
+  out.setf(std::ios::fixed, std::ios::floatfield);
+  out.precision(3);
+
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  const char* separator = "\n";
+  for (int t = 0; t < trace_tracks; ++t) {
+    out << separator << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,"
+        << "\"tid\":" << t << ",\"args\":{\"name\":\"thread " << t << "\"}}";
+    separator = ",\n";
+  }
+  for_each_trace_event([&](int track, const trace_event& e) {
+    out << separator << "{\"name\":\"loop " << e.loop;
+    if (e.step > 0) {
+      out << '.' << e.step;
+    }
+    out << "\",\"cat\":\"" << (e.stolen_from >= 0 ? "stolen" : "chunk")
+        << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << track
+        << ",\"ts\":" << (e.start - origin) * 1e6
+        << ",\"dur\":" << (e.stop - e.start) * 1e6 << ",\"args\":{\"loop\":"
+        << e.loop << ",\"step\":" << e.step << ",\"thread\":" << e.thread
+        << ",\"begin\":" << e.begin << ",\"end\":" << e.end
+        << ",\"stolen_from\":" << e.stolen_from << "}}";
+    separator = ",\n";
+  });
+  out << "\n]}\n";
+
+  out.flags(flags);
+  out.precision(precision);
+}
+
+bool write_trace(const char* path)
+{
+  std::ofstream out(path);
+  if (!out) {
+    return false;
+  }
+  write_trace(out);
+  return static_cast<bool>(out);
+}
+
+#if defined(RAJA_ENABLE_LWS_TRACE)
+
+namespace detail
+{
+
+namespace
+{
+
+std::atomic<long> trace_loops{0};
+
+thread_local trace_buffer* my_trace_buffer = nullptr;
+
+thread_local trace_loop next_trace_loop{0, 0};
+
+}  // closing brace for anonymous namespace
+
+trace_buffer* trace_thread_buffer()
+{
+  if (my_trace_buffer == nullptr) {
+    trace_buffer* b = new trace_buffer;
+    b->events = new trace_event[trace_capacity];
+    b->size.store(0, std::memory_order_relaxed);
+    b->dropped = 0;
+    std::lock_guard<std::mutex> lock(trace_mutex());
+    b->track = trace_tracks++;
+    b->next = trace_buffers;
+    trace_buffers = b;
+    my_trace_buffer = b;
+  }
+  return my_trace_buffer;
+}
+
+trace_loop trace_new_loop()
+{
+  return trace_loop{trace_loops.fetch_add(1, std::memory_order_relaxed) + 1,
+                    0};
+}
+
+void trace_next_loop(trace_loop loop) { next_trace_loop = loop; }
+
+trace_loop trace_take_loop()
+{
+  const trace_loop loop = next_trace_loop;
+  next_trace_loop = trace_loop{0, 0};
+  return loop;
+}
+
+}  // closing brace for detail namespace
+
+#endif
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for RAJA_ENABLE_OPENMP or RAJA_ENABLE_LWS_THREADS
@@ -0,0 +1,252 @@
+/*!
+ ******************************************************************************
+ *
+ * \file
+ *
+ * \brief   Implementation file for the online tuning of the lws schedule
+ *          parameters.
+ *
+ ******************************************************************************
+ */
+
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+#include "RAJA/config.hpp"
+
+#if defined(RAJA_ENABLE_OPENMP)
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+
+#include "RAJA/policy/openmp/lws_tuning.hpp"
+
+namespace RAJA
+{
+namespace lws
+{
+
+namespace
+{
+
+// the defaults of vSched
+const float initial_static_fraction = 0.5f;
+const int initial_chunk_size = 16;
+const int max_chunk_size = 4096;
+
+// runs averaged before the parameters are changed, to smooth out noise
+const int window = 4;
+
+// relative finish-time spread above which the loop is imbalanced, and below
+// which it is balanced well enough to try a cheaper schedule
+const double skew_high = 0.10;
+const double skew_low = 0.03;
+
+// steals per thread and loop above which chunks are too small
+const double steals_high = 8.0;
+
+// the search stops when the static fraction step gets this small, when the
+// parameters did not change for stable_windows windows, or after max_windows
+const float min_step = 1.0f / 32;
+const int stable_windows = 3;
+const int max_windows = 32;
+
+struct tuning_state {
+  tuned_parameters params;
+  float step;
+  int last_direction;
+  int stable;
+  int windows;
+  // sums over the current window
+  int samples;
+  double skew;
+  double steals_per_thread;
+};
+
+tuning_state initial_state()
+{
+  tuning_state state{};
+  state.params.static_fraction = initial_static_fraction;
+  state.params.chunk_size = initial_chunk_size;
+  state.step = 0.25f;
+  return state;
+}
+
+std::mutex& tuning_mutex()
+{
+  static std::mutex m;
+  return m;
+}
+
+std::map<tuning_key, tuning_state>& tuning_table()
+{
+  static std::map<tuning_key, tuning_state> table;
+  return table;
+}
+
+tuning_state& find_or_insert(const tuning_key& key)
+{
+  auto& table = tuning_table();
+  auto it = table.find(key);
+  if (it == table.end()) {
+    it = table.emplace(key, initial_state()).first;
+  }
+  return it->second;
+}
+
+void move_static_fraction(tuning_state& state, int direction)
+{
+  float f = state.params.static_fraction;
+  if (state.last_direction == -direction) {
+    state.step /= 2;
+  }
+  state.last_direction = direction;
+  f = std::min(1.0f, std::max(0.0f, f + direction * state.step));
+  if (f == state.params.static_fraction) {
+    ++state.stable;  // already at the bound
+  } else {
+    state.params.static_fraction = f;
+    state.stable = 0;
+  }
+}
+
+void change_chunk_size(tuning_state& state, int chunk_size)
+{
+  chunk_size = std::min(max_chunk_size, std::max(1, chunk_size));
+  if (chunk_size == state.params.chunk_size) {
+    ++state.stable;
+  } else {
+    state.params.chunk_size = chunk_size;
+    state.stable = 0;
+  }
+}
+
+// An imbalanced loop gets a larger dynamic part, and smaller chunks once it
+// is fully dynamic. A balanced loop that did not need to steal gets a larger
+// static part, and one that stole a lot gets larger chunks.
+void adjust(tuning_state& state)
+{
+  const double skew = state.skew / state.samples;
+  const double steals = state.steals_per_thread / state.samples;
+
+  if (skew > skew_high) {
+    if (state.params.static_fraction > 0.0f) {
+      move_static_fraction(state, -1);
+    } else {
+      change_chunk_size(state, state.params.chunk_size / 2);
+    }
+  } else if (skew < skew_low && steals < 1.0) {
+    move_static_fraction(state, +1);
+  } else if (skew < skew_low && steals > steals_high) {
+    change_chunk_size(state, state.params.chunk_size * 2);
+  } else {
+    ++state.stable;
+  }
+
+  ++state.windows;
+  state.params.converged = state.step < min_step
+                           || state.stable >= stable_windows
+                           || state.windows >= max_windows;
+}
+
+}  // closing brace for anonymous namespace
+
+tuned_parameters get_tuning(const tuning_key& key)
+{
+  std::lock_guard<std::mutex> lock(tuning_mutex());
+  auto& table = tuning_table();
+  auto it = table.find(key);
+  return it == table.end() ? initial_state().params : it->second.params;
+}
+
+std::vector<std::pair<tuning_key, tuned_parameters>> get_all_tuning()
+{
+  std::lock_guard<std::mutex> lock(tuning_mutex());
+  std::vector<std::pair<tuning_key, tuned_parameters>> all;
+  for (const auto& entry : tuning_table()) {
+    all.emplace_back(entry.first, entry.second.params);
+  }
+  return all;
+}
+
+void pin_tuning(const tuning_key& key, float static_fraction, int chunk_size)
+{
+  std::lock_guard<std::mutex> lock(tuning_mutex());
+  tuning_state& state = find_or_insert(key);
+  state.params.static_fraction = std::min(1.0f, std::max(0.0f, static_fraction));
+  state.params.chunk_size = std::max(1, chunk_size);
+  state.params.pinned = true;
+}
+
+void unpin_tuning(const tuning_key& key)
+{
+  std::lock_guard<std::mutex> lock(tuning_mutex());
+  auto& table = tuning_table();
+  auto it = table.find(key);
+  if (it != table.end() && it->second.params.pinned) {
+    tuning_state restarted = initial_state();
+    restarted.params.static_fraction = it->second.params.static_fraction;
+    restarted.params.chunk_size = it->second.params.chunk_size;
+    restarted.params.invocations = it->second.params.invocations;
+    it->second = restarted;
+  }
+}
+
+void reset_tuning()
+{
+  std::lock_guard<std::mutex> lock(tuning_mutex());
+  tuning_table().clear();
+}
+
+namespace detail
+{
+
+tuned_parameters tuning_begin(const tuning_key& key)
+{
+  std::lock_guard<std::mutex> lock(tuning_mutex());
+  tuning_state& state = find_or_insert(key);
+  ++state.params.invocations;
+  return state.params;
+}
+
+void tuning_end(const tuning_key& key, const tuning_sample& sample)
+{
+  std::lock_guard<std::mutex> lock(tuning_mutex());
+  tuning_state& state = find_or_insert(key);
+  if (state.params.pinned || state.params.converged) {
+    return;
+  }
+  // the first run of a call site pays for cold caches and allocations
+  if (state.params.invocations == 1) {
+    return;
+  }
+  state.skew += sample.skew;
+  state.steals_per_thread +=
+      static_cast<double>(sample.steals) / std::max(1, sample.num_threads);
+  if (++state.samples == window) {
+    adjust(state);
+    state.samples = 0;
+    state.skew = 0.0;
+    state.steals_per_thread = 0.0;
+  }
+}
+
+}  // closing brace for detail namespace
+
+}  // closing brace for lws namespace
+}  // closing brace for RAJA namespace
+
+#endif  // closing endif for if defined(RAJA_ENABLE_OPENMP)
@@ -88,7 +88,8 @@ TYPED_TEST_P(ForallViewTest, ForallViewOffsetLayout)
 
 REGISTER_TYPED_TEST_CASE_P(ForallViewTest, ForallViewLayout, ForallViewOffsetLayout);
 
-using SequentialTypes = ::testing::Types< seq_exec, loop_exec, simd_exec >;
+using SequentialTypes =
+    ::testing::Types< seq_exec, loop_exec, simd_exec, simd_lanes_exec<> >;
 
 INSTANTIATE_TYPED_TEST_CASE_P(Sequential, ForallViewTest, SequentialTypes);
 
@@ -108,7 +108,9 @@ REGISTER_TYPED_TEST_CASE_P(ForallTest, BasicForall, BasicForallIcount);
 using SequentialTypes = ::testing::Types<
     ExecPolicy<seq_segit, seq_exec>,
     ExecPolicy<seq_segit, loop_exec>,
-    ExecPolicy<seq_segit, simd_exec> >;
+    ExecPolicy<seq_segit, simd_exec>,
+    ExecPolicy<seq_segit, simd_lanes_exec<>>,
+    ExecPolicy<seq_segit, simd_lanes_exec<3>> >;
 
 INSTANTIATE_TYPED_TEST_CASE_P(Sequential, ForallTest, SequentialTypes);
 
@@ -117,7 +119,11 @@ INSTANTIATE_TYPED_TEST_CASE_P(Sequential, ForallTest, SequentialTypes);
 using OpenMPTypes = ::testing::Types<
     ExecPolicy<seq_segit, omp_parallel_for_exec>,
     ExecPolicy<omp_parallel_for_segit, seq_exec>,
-    ExecPolicy<omp_parallel_for_segit, loop_exec> >;
+    ExecPolicy<omp_parallel_for_segit, loop_exec>,
+    ExecPolicy<omp_lws_segit, seq_exec>,
+    ExecPolicy<omp_lws_segit, loop_exec>,
+    ExecPolicy<seq_segit, omp_lws>,
+    ExecPolicy<seq_segit, omp_parallel_for_lws<>> >;
 
 INSTANTIATE_TYPED_TEST_CASE_P(OpenMP, ForallTest, OpenMPTypes);
 #endif
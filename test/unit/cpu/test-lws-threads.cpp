@@ -0,0 +1,234 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// Source file containing tests for the std::thread lws policies
+///
+
+#include "RAJA/RAJA.hpp"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#if defined(RAJA_ENABLE_LWS_THREADS)
+
+static void checkEachIndexOnce(const std::vector<std::atomic<int>>& hits)
+{
+  for (size_t i = 0; i < hits.size(); ++i) {
+    ASSERT_EQ(1, hits[i].load()) << "index " << i;
+  }
+}
+
+TEST(LwsThreadsTest, PoolHasThreads)
+{
+  ASSERT_GE(RAJA::lws::get_num_threads(), 1);
+}
+
+TEST(LwsThreadsTest, ExecCoversRange)
+{
+  const float fractions[] = {0.0f, 0.5f, 1.0f};
+  const int lengths[] = {0, 1, 13, 1000, 100003};
+
+  for (float f : fractions) {
+    setStaticFraction(f, 7);
+    for (int len : lengths) {
+      std::vector<std::atomic<int>> hits(len);
+      for (auto& h : hits) {
+        h.store(0);
+      }
+      std::atomic<int>* h = hits.data();
+      RAJA::forall<RAJA::lws_exec>(RAJA::RangeSegment(0, len),
+                                   [=](int i) { h[i]++; });
+      checkEachIndexOnce(hits);
+    }
+  }
+}
+
+template <typename Strategy>
+static void checkStrategy()
+{
+  const int len = 10007;
+  std::vector<std::atomic<int>> hits(len);
+  for (auto& h : hits) {
+    h.store(0);
+  }
+  std::atomic<int>* h = hits.data();
+  RAJA::forall<RAJA::lws_strategy_exec<Strategy, 25, 5>>(
+      RAJA::RangeSegment(0, len), [=](int i) { h[i]++; });
+  checkEachIndexOnce(hits);
+}
+
+TEST(LwsThreadsTest, StrategiesCoverRange)
+{
+  checkStrategy<RAJA::lws::static_schedule>();
+  checkStrategy<RAJA::lws::static_fraction>();
+  checkStrategy<RAJA::lws::statdynstaggered>();
+  setCDY(0.5f, 1.0, 5);
+  checkStrategy<RAJA::lws::cdy>();
+  checkStrategy<RAJA::lws::guided>();
+  checkStrategy<RAJA::lws::factoring>();
+  checkStrategy<RAJA::lws::trapezoid>();
+}
+
+TEST(LwsThreadsTest, WeightedCoversRange)
+{
+  const int lengths[] = {0, 1, 13, 1000, 100003};
+
+  setStaticFraction(0.5f, 4);
+  for (int len : lengths) {
+    std::vector<long> cost(len), offsets(len + 1, 0);
+    for (int i = 0; i < len; ++i) {
+      cost[i] = (i % 7 == 0) ? 100 : i % 3;
+      offsets[i + 1] = offsets[i] + cost[i];
+    }
+
+    std::vector<std::atomic<int>> hits(len);
+    for (auto& h : hits) {
+      h.store(0);
+    }
+    std::atomic<int>* h = hits.data();
+    RAJA::forall(RAJA::lws_weighted_exec<long>(
+                     RAJA::lws::iteration_costs(cost.data())),
+                 RAJA::RangeSegment(0, len),
+                 [=](int i) { h[i]++; });
+    RAJA::forall(RAJA::lws_weighted_exec<long>(
+                     RAJA::lws::cost_prefix(offsets.data())),
+                 RAJA::RangeSegment(0, len),
+                 [=](int i) { h[i]++; });
+    for (int i = 0; i < len; ++i) {
+      ASSERT_EQ(2, hits[i].load()) << "index " << i;
+    }
+  }
+}
+
+TEST(LwsThreadsTest, BackToBackLoops)
+{
+  const int len = 4096;
+  std::vector<int> counts(len, 0);
+  int* c = counts.data();
+
+  for (int rep = 0; rep < 200; ++rep) {
+    RAJA::forall<RAJA::lws_exec>(RAJA::RangeSegment(0, len),
+                                 [=](int i) { c[i]++; });
+  }
+
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(200, counts[i]);
+  }
+}
+
+TEST(LwsThreadsTest, NestedLoopsRunOnTheirThread)
+{
+  const int outer = 64;
+  const int inner = 100;
+  std::vector<int> counts(outer * inner, 0);
+  int* c = counts.data();
+
+  RAJA::forall<RAJA::lws_exec>(RAJA::RangeSegment(0, outer), [=](int i) {
+    RAJA::forall<RAJA::lws_exec>(RAJA::RangeSegment(0, inner),
+                                 [=](int j) { c[i * inner + j]++; });
+  });
+
+  for (int i = 0; i < outer * inner; ++i) {
+    ASSERT_EQ(1, counts[i]);
+  }
+}
+
+TEST(LwsThreadsTest, LoopsFromSeveralThreads)
+{
+  const int len = 20000;
+  std::vector<long> sums(4, 0);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&sums, t]() {
+      for (int rep = 0; rep < 10; ++rep) {
+        RAJA::ReduceSum<RAJA::lws_reduce, long> sum(0);
+        RAJA::forall<RAJA::lws_exec>(RAJA::RangeSegment(0, len),
+                                     [=](int i) { sum += i; });
+        sums[t] += sum.get();
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+
+  for (int t = 0; t < 4; ++t) {
+    ASSERT_EQ(10L * len * (len - 1) / 2, sums[t]);
+  }
+}
+
+TEST(LwsThreadsTest, Reductions)
+{
+  const int len = 100003;
+  std::vector<double> a(len);
+  for (int i = 0; i < len; ++i) {
+    a[i] = (i * 37) % 1001 - 500;
+  }
+  a[4242] = -1000.0;
+  a[777] = 2000.0;
+  const double* d = a.data();
+
+  RAJA::ReduceSum<RAJA::lws_reduce, double> sum(0.0);
+  RAJA::ReduceMin<RAJA::lws_reduce, double> min(0.0);
+  RAJA::ReduceMaxLoc<RAJA::lws_reduce, double> maxloc(0.0, -1);
+
+  RAJA::forall<RAJA::lws_exec>(RAJA::RangeSegment(0, len), [=](int i) {
+    sum += d[i];
+    min.min(d[i]);
+    maxloc.maxloc(d[i], i);
+  });
+
+  ASSERT_EQ(std::accumulate(a.begin(), a.end(), 0.0), sum.get());
+  ASSERT_EQ(-1000.0, min.get());
+  ASSERT_EQ(2000.0, maxloc.get());
+  ASSERT_EQ(777, maxloc.getLoc());
+}
+
+TEST(LwsThreadsTest, Scans)
+{
+  const int lengths[] = {0, 1, 2, 3, 1000, 100003};
+
+  for (int len : lengths) {
+    std::vector<int> in(len);
+    for (int i = 0; i < len; ++i) {
+      in[i] = (i * 7) % 13;
+    }
+
+    std::vector<int> inclusive(len), expected(len);
+    std::partial_sum(in.begin(), in.end(), expected.begin());
+    RAJA::inclusive_scan<RAJA::lws_exec>(in.data(),
+                                         in.data() + len,
+                                         inclusive.data());
+    ASSERT_EQ(expected, inclusive);
+
+    std::vector<int> exclusive(in);
+    RAJA::exclusive_scan_inplace<RAJA::lws_exec>(exclusive.data(),
+                                                 exclusive.data() + len,
+                                                 RAJA::operators::plus<int>{},
+                                                 5);
+    int running = 5;
+    for (int i = 0; i < len; ++i) {
+      ASSERT_EQ(running, exclusive[i]) << "index " << i;
+      running += in[i];
+    }
+  }
+}
+
+#endif
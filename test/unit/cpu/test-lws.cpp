@@ -0,0 +1,1436 @@
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+// Copyright (c) 2016-18, Lawrence Livermore National Security, LLC.
+//
+// Produced at the Lawrence Livermore National Laboratory
+//
+// LLNL-CODE-689114
+//
+// All rights reserved.
+//
+// This file is part of RAJA.
+//
+// For details about use and distribution, please read RAJA/LICENSE.
+//
+//~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~//
+
+///
+/// Source file containing tests for the lws (lightweight scheduling) policies
+///
+
+#include "RAJA/RAJA.hpp"
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#if defined(RAJA_ENABLE_OPENMP)
+
+static void checkEachIndexOnce(const std::vector<int>& hits)
+{
+  for (size_t i = 0; i < hits.size(); ++i) {
+    ASSERT_EQ(1, hits[i]) << "index " << i;
+  }
+}
+
+TEST(LwsTest, StatDynStaggeredCoversRange)
+{
+  const float fractions[] = {0.0f, 0.25f, 0.5f, 1.0f};
+  const int chunks[] = {1, 7, 64};
+  const int lengths[] = {0, 1, 13, 1000, 100003};
+
+  for (float f : fractions) {
+    for (int chunk : chunks) {
+      setStaticFraction(f, chunk);
+      for (int len : lengths) {
+        std::vector<int> hits(len, 0);
+        int* h = hits.data();
+        RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+          h[i]++;
+        });
+        checkEachIndexOnce(hits);
+      }
+    }
+  }
+}
+
+TEST(LwsTest, StatDynStaggeredBackToBack)
+{
+  const int len = 4096;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+
+  setStaticFraction(0.5f, 3);
+  for (int rep = 0; rep < 100; ++rep) {
+    RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+      h[i]++;
+    });
+  }
+
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(100, hits[i]);
+  }
+}
+
+// the loop_start_*()/loop_next_*() functions without a context share one
+// counter, which every loop has to set up again
+TEST(LwsTest, SharedCounterBackToBack)
+{
+  using StartFn = int (*)(int, int, int*, int*, int, int);
+  using NextFn = int (*)(int*, int*, int);
+  const StartFn starts[] = {loop_start_static_fraction,
+                            loop_start_guided,
+                            loop_start_factoring,
+                            loop_start_trapezoid,
+                            loop_start_cdy};
+  const NextFn nexts[] = {[](int* s, int* e, int) {
+                            return loop_next_static_fraction(s, e);
+                          },
+                          loop_next_guided,
+                          loop_next_factoring,
+                          loop_next_trapezoid,
+                          loop_next_cdy};
+  const int len = 1000;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+
+  setCDY(0.5f, 1.0, 7);
+  for (int s = 0; s < 5; ++s) {
+    for (int rep = 0; rep < 20; ++rep) {
+#pragma omp parallel
+      {
+        const int tid = omp_get_thread_num();
+        int start, end;
+        starts[s](0, len, &start, &end, tid, omp_get_num_threads());
+        do {
+          for (int i = start; i < end; ++i) {
+#pragma omp atomic
+            h[i]++;
+          }
+        } while (nexts[s](&start, &end, tid));
+      }
+    }
+    for (int i = 0; i < len; ++i) {
+      ASSERT_EQ(20, hits[i]) << "strategy " << s << ", index " << i;
+    }
+    std::fill(hits.begin(), hits.end(), 0);
+  }
+  setStaticFraction(0.5f, 16);
+}
+
+TEST(LwsTest, StatDynStaggeredImbalanced)
+{
+  const int len = 2000;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+
+  setStaticFraction(0.2f, 4);
+  // the first iterations are much more expensive than the rest, so the
+  // threads owning them only finish if the other threads steal from them
+  RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int i) {
+    volatile double x = 0.0;
+    for (int k = 0; k < (i < len / 4 ? 2000 : 1); ++k) {
+      x = x + k;
+    }
+#pragma omp atomic
+    h[i]++;
+  });
+
+  checkEachIndexOnce(hits);
+}
+
+TEST(LwsTest, StealStrategiesCoverRange)
+{
+  const int strategies[] = {VSCHED_VICTIM_RANDOM,
+                            VSCHED_VICTIM_ROUND_ROBIN,
+                            VSCHED_VICTIM_MOST_WORK,
+                            VSCHED_VICTIM_HIERARCHICAL};
+  const int len = 20011;
+
+  for (int strategy : strategies) {
+    for (int half = 0; half < 2; ++half) {
+      setStealStrategy(strategy, half);
+      for (float f : {0.0f, 0.5f}) {
+        setStaticFraction(f, 5);
+        std::vector<int> hits(len, 0);
+        std::vector<int> owner(len, -1);
+        std::atomic<int> others{0};
+        std::atomic<bool> started{false};
+        int* h = hits.data();
+        int* o = owner.data();
+        std::atomic<int>* ran = &others;
+        std::atomic<bool>* st = &started;
+        // how long thread 0 waits at most, so that the test fails rather
+        // than hangs if nothing is stolen
+        const auto limit =
+            std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        RAJA::lws::reset_stats();
+        RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int i) {
+          const int tid = omp_get_thread_num();
+          const int nthreads = omp_get_num_threads();
+          if (tid != 0) {
+            // thread 0's queue is set up once it runs an iteration
+            while (!st->load()) {
+              std::this_thread::yield();
+            }
+            ran->fetch_add(1);
+          } else if (nthreads > 1) {
+            // thread 0 holds on to its share until the other threads ran
+            // more than theirs, which they can only do by stealing from it
+            st->store(true);
+            const int theirs = len - len / nthreads;
+            while (ran->load() <= theirs
+                   && std::chrono::steady_clock::now() < limit) {
+              std::this_thread::yield();
+            }
+          }
+          o[i] = tid;
+#pragma omp atomic
+          h[i]++;
+        });
+        checkEachIndexOnce(hits);
+
+        if (omp_get_max_threads() > 1) {
+          // thread 0's share is [0, len / numThreads)
+          const int share = len / omp_get_max_threads();
+          const long stolen =
+              std::count_if(owner.begin(),
+                            owner.begin() + share,
+                            [](int t) { return t != 0; });
+          ASSERT_GT(stolen, 0) << "strategy " << strategy << ", half "
+                               << half << ", fraction " << f;
+          if (RAJA::lws::stats_enabled) {
+            ASSERT_GT(RAJA::lws::get_stats().stolen, 0u);
+          }
+        }
+      }
+    }
+  }
+  setStealStrategy(VSCHED_VICTIM_RANDOM, 0);
+}
+
+TEST(LwsTest, ConcurrentLoops)
+{
+  const int len = 10007;
+  const int numLoops = 4;
+  std::vector<std::vector<int>> hits(numLoops, std::vector<int>(len, 0));
+  std::vector<std::thread> threads;
+
+  setStaticFraction(0.3f, 3);
+  for (int t = 0; t < numLoops; ++t) {
+    int* h = hits[t].data();
+    threads.emplace_back([=]() {
+      for (int rep = 0; rep < 20; ++rep) {
+        RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+          h[i]++;
+        });
+      }
+    });
+  }
+  for (auto& th : threads) {
+    th.join();
+  }
+
+  for (int t = 0; t < numLoops; ++t) {
+    for (int i = 0; i < len; ++i) {
+      ASSERT_EQ(20, hits[t][i]);
+    }
+  }
+}
+
+TEST(LwsTest, NestedLoops)
+{
+  const int outer = 17;
+  const int inner = 501;
+  std::vector<int> hits(outer * inner, 0);
+  int* h = hits.data();
+
+  RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, outer), [=](int i) {
+    RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, inner), [=](int j) {
+#pragma omp atomic
+      h[i * inner + j]++;
+    });
+  });
+
+  checkEachIndexOnce(hits);
+}
+
+TEST(LwsTest, ForExecInsideRegion)
+{
+  const int len = 3001;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+
+  RAJA::region<RAJA::omp_parallel_region>([=]() {
+    for (int rep = 0; rep < 3; ++rep) {
+      RAJA::forall<RAJA::omp_lws_for_exec>(RAJA::RangeSegment(0, len),
+                                           [=](int i) {
+#pragma omp atomic
+                                             h[i]++;
+                                           });
+    }
+  });
+
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(3, hits[i]);
+  }
+}
+
+template <typename POLICY>
+class LwsPolicyTest : public ::testing::Test
+{
+};
+
+TYPED_TEST_CASE_P(LwsPolicyTest);
+
+TYPED_TEST_P(LwsPolicyTest, CoversRange)
+{
+  for (int len : {0, 1, 13, 1000, 100003}) {
+    std::vector<int> hits(len, 0);
+    int* h = hits.data();
+    RAJA::forall<TypeParam>(RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+      h[i]++;
+    });
+    checkEachIndexOnce(hits);
+  }
+}
+
+TYPED_TEST_P(LwsPolicyTest, CoversRangeBackToBack)
+{
+  const int len = 4096;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+
+  for (int rep = 0; rep < 50; ++rep) {
+    RAJA::forall<TypeParam>(RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+      h[i]++;
+    });
+  }
+
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(50, hits[i]);
+  }
+}
+
+REGISTER_TYPED_TEST_CASE_P(LwsPolicyTest, CoversRange, CoversRangeBackToBack);
+
+using LwsPolicies = ::testing::Types<
+    RAJA::omp_parallel_for_lws<>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::static_schedule, 100, 1>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::static_fraction, 30, 8>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::static_fraction, 0, 1>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::statdynstaggered, 0, 3>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::statdynstaggered, 100, 64>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::guided, 0, 1>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::guided, 40, 7>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::factoring, 0, 1>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::factoring, 40, 7>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::trapezoid, 0, 1>,
+    RAJA::omp_parallel_for_lws<RAJA::lws::trapezoid, 40, 7>>;
+
+INSTANTIATE_TYPED_TEST_CASE_P(OpenMP, LwsPolicyTest, LwsPolicies);
+
+TEST(LwsTest, CompileTimePoliciesInsideRegion)
+{
+  const int len = 3001;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+
+  RAJA::region<RAJA::omp_parallel_region>([=]() {
+    RAJA::forall<RAJA::omp_for_lws<RAJA::lws::static_schedule, 100, 1>>(
+        RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+          h[i]++;
+        });
+    RAJA::forall<RAJA::omp_for_lws<RAJA::lws::static_fraction, 50, 4>>(
+        RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+          h[i]++;
+        });
+    RAJA::forall<RAJA::omp_for_lws<RAJA::lws::statdynstaggered, 25, 2>>(
+        RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+          h[i]++;
+        });
+  });
+
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(3, hits[i]);
+  }
+}
+
+TEST(LwsTest, CdyCoversRange)
+{
+  const int len = 5003;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+
+  setCDY(0.5f, 1.0, 7);
+  RAJA::forall<RAJA::omp_parallel_for_lws<RAJA::lws::cdy, 50, 7>>(
+      RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+        h[i]++;
+      });
+
+  checkEachIndexOnce(hits);
+}
+
+struct CdyProbe {
+  std::atomic<int> calls{0};
+  std::atomic<int> badStates{0};
+};
+
+// lets a thread through every other draw, and checks what it is given
+static int cdyEveryOtherDraw(const vSched_cdy_state* state, void* arg)
+{
+  CdyProbe* probe = static_cast<CdyProbe*>(arg);
+  probe->calls++;
+  if (state->tid < 0 || state->tid >= state->numThreads
+      || state->next < state->dynBegin || state->next >= state->loopEnd
+      || state->elapsed < 0.0 || state->random < 0.0 || state->random >= 1.0) {
+    probe->badStates++;
+  }
+  return state->random < 0.5;
+}
+
+TEST(LwsTest, CdyConstraintCallback)
+{
+  const int len = 5003;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+  CdyProbe probe;
+
+  setCDY(0.5f, 0.0, 7);
+  setCDYConstraint(cdyEveryOtherDraw, &probe);
+  RAJA::forall<RAJA::omp_parallel_for_lws<RAJA::lws::cdy, 50, 7>>(
+      RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+        h[i]++;
+      });
+  setCDYConstraint(nullptr, nullptr);
+
+  checkEachIndexOnce(hits);
+  ASSERT_GT(probe.calls.load(), 0);
+  ASSERT_EQ(0, probe.badStates.load());
+
+  // with the default predicate, random < constraint, a low constraint only
+  // slows the dequeues down
+  std::fill(hits.begin(), hits.end(), 0);
+  setCDY(0.25f, 0.1, 7);
+  RAJA::forall<RAJA::omp_parallel_for_lws<RAJA::lws::cdy, 25, 7>>(
+      RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+        h[i]++;
+      });
+  checkEachIndexOnce(hits);
+  setCDY(0.5f, 1.0, 7);
+}
+
+TEST(LwsTest, SelfSchedulingChunksShrink)
+{
+  using StartFn = int (*)(vSched_context*, int, int, int*, int*, int, int);
+  using NextFn = int (*)(vSched_context*, int*, int*, int);
+  const StartFn starts[] = {loop_start_guided_ctx,
+                            loop_start_factoring_ctx,
+                            loop_start_trapezoid_ctx};
+  const NextFn nexts[] = {loop_next_guided_ctx,
+                          loop_next_factoring_ctx,
+                          loop_next_trapezoid_ctx};
+  const int numThreads = 4;
+  const int len = 10000;
+
+  for (int s = 0; s < 3; ++s) {
+    vSched_context* ctx = vSched_context_acquire(numThreads);
+    ASSERT_NE(nullptr, ctx);
+    vSched_context_set_static_fraction(ctx, 0.0f, 2);
+
+    // one thread takes every chunk, so they come out in order
+    int start, end;
+    starts[s](ctx, 0, len, &start, &end, 0, numThreads);
+    ASSERT_EQ(start, end);
+    int expected = 0;
+    int lastSize = len;
+    while (nexts[s](ctx, &start, &end, 0)) {
+      ASSERT_EQ(expected, start);
+      ASSERT_LT(start, end);
+      if (end < len) {
+        ASSERT_LE(end - start, lastSize);
+        ASSERT_GE(end - start, 2);
+      }
+      lastSize = end - start;
+      expected = end;
+    }
+    ASSERT_EQ(len, expected);
+    vSched_context_release(ctx);
+  }
+}
+
+TEST(LwsTest, TunedConverges)
+{
+  const int len = 20000;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+  auto body = [=](int i) {
+#pragma omp atomic
+    h[i]++;
+  };
+
+  RAJA::lws::reset_tuning();
+  const int reps = 200;
+  for (int rep = 0; rep < reps; ++rep) {
+    RAJA::forall<RAJA::omp_lws_tuned>(RAJA::RangeSegment(0, len), body);
+  }
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(reps, hits[i]);
+  }
+
+  auto params =
+      RAJA::lws::get_tuning(RAJA::lws::make_tuning_key(body, len));
+  ASSERT_EQ(reps, params.invocations);
+  ASSERT_TRUE(params.converged);
+  ASSERT_FALSE(params.pinned);
+  ASSERT_GE(params.static_fraction, 0.0f);
+  ASSERT_LE(params.static_fraction, 1.0f);
+  ASSERT_GE(params.chunk_size, 1);
+
+  auto all = RAJA::lws::get_all_tuning();
+  ASSERT_EQ(1u, all.size());
+  ASSERT_EQ(len, all[0].first.range_size);
+}
+
+TEST(LwsTest, TunedPinned)
+{
+  const int len = 5000;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+  auto body = [=](int i) {
+#pragma omp atomic
+    h[i]++;
+  };
+  auto key = RAJA::lws::make_tuning_key(body, len);
+
+  RAJA::lws::reset_tuning();
+  RAJA::lws::pin_tuning(key, 0.25f, 3);
+  for (int rep = 0; rep < 20; ++rep) {
+    RAJA::forall<RAJA::omp_lws_tuned>(RAJA::RangeSegment(0, len), body);
+  }
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(20, hits[i]);
+  }
+
+  auto params = RAJA::lws::get_tuning(key);
+  ASSERT_TRUE(params.pinned);
+  ASSERT_EQ(0.25f, params.static_fraction);
+  ASSERT_EQ(3, params.chunk_size);
+  ASSERT_EQ(20, params.invocations);
+
+  // a different range size is a different call site
+  RAJA::forall<RAJA::omp_lws_tuned>(RAJA::RangeSegment(0, len / 2), body);
+  ASSERT_FALSE(RAJA::lws::get_tuning(RAJA::lws::make_tuning_key(body, len / 2))
+                   .pinned);
+
+  RAJA::lws::unpin_tuning(key);
+  params = RAJA::lws::get_tuning(key);
+  ASSERT_FALSE(params.pinned);
+  ASSERT_EQ(0.25f, params.static_fraction);
+  RAJA::lws::reset_tuning();
+}
+
+TEST(LwsTest, StickyReplaysAssignment)
+{
+  const int len = 10007;
+  std::vector<int> owner(len, -1);
+  std::vector<int> hits(len, 0);
+  int* o = owner.data();
+  int* h = hits.data();
+  auto body = [=](int i) {
+    o[i] = omp_get_thread_num();
+#pragma omp atomic
+    h[i]++;
+  };
+  auto key = RAJA::lws::make_tuning_key(body, len);
+
+  RAJA::lws::reset_sticky_schedules();
+  setStaticFraction(0.2f, 4);
+  // a threshold of 100% never re-schedules
+  RAJA::forall<RAJA::omp_lws_sticky<100>>(RAJA::RangeSegment(0, len), body);
+  std::vector<int> recorded = owner;
+  // replays without a dynamic part, so that nothing is stolen
+  setStaticFraction(1.0f, 4);
+  for (int rep = 1; rep < 20; ++rep) {
+    RAJA::forall<RAJA::omp_lws_sticky<100>>(RAJA::RangeSegment(0, len), body);
+    for (int i = 0; i < len; ++i) {
+      ASSERT_EQ(recorded[i], owner[i]) << "index " << i;
+    }
+  }
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(20, hits[i]);
+  }
+
+  auto info = RAJA::lws::get_sticky_info(key);
+  ASSERT_EQ(1, info.recordings);
+  ASSERT_EQ(19, info.replays);
+  ASSERT_TRUE(info.recorded);
+
+  RAJA::lws::reset_sticky_schedules();
+  ASSERT_EQ(0, RAJA::lws::get_sticky_info(key).recordings);
+}
+
+TEST(LwsTest, StickyReplaysSteal)
+{
+  const int len = 2000;
+  std::vector<int> owner(len, -1);
+  std::vector<int> recorded(len, -1);
+  std::vector<int> hits(len, 0);
+  std::atomic<bool> started{false};
+  int* o = owner.data();
+  const int* r = recorded.data();
+  int* h = hits.data();
+  std::atomic<bool>* st = &started;
+  auto body = [=](int i) {
+    // in the replay, the iterations recorded for thread 0 get slow, and the
+    // other threads don't finish before thread 0 has started
+    if (r[i] == 0) {
+      st->store(true);
+    }
+    volatile double x = 0.0;
+    for (int k = 0; k < (r[i] == 0 ? 20000 : 1); ++k) {
+      x = x + k;
+    }
+    while (r[i] > 0 && !st->load()) {
+      std::this_thread::yield();
+    }
+    o[i] = omp_get_thread_num();
+#pragma omp atomic
+    h[i]++;
+  };
+
+  RAJA::lws::reset_sticky_schedules();
+  setStaticFraction(0.0f, 4);
+  RAJA::forall<RAJA::omp_lws_sticky<100>>(RAJA::RangeSegment(0, len), body);
+  recorded = owner;
+  started = std::count(recorded.begin(), recorded.end(), 0) == 0;
+  RAJA::forall<RAJA::omp_lws_sticky<100>>(RAJA::RangeSegment(0, len), body);
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(2, hits[i]);
+  }
+
+  auto info = RAJA::lws::get_sticky_info(RAJA::lws::make_tuning_key(body, len));
+  ASSERT_EQ(1, info.replays);
+  // the other threads took some of thread 0's recorded iterations
+  int moved = 0;
+  for (int i = 0; i < len; ++i) {
+    moved += recorded[i] == 0 && owner[i] != 0;
+  }
+  if (omp_get_max_threads() > 1
+      && std::count(recorded.begin(), recorded.end(), 0) > 8) {
+    ASSERT_GT(moved, 0);
+  }
+  RAJA::lws::reset_sticky_schedules();
+}
+
+TEST(LwsTest, StickyResetDuringRecording)
+{
+  const int len = 1000;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+  auto body = [=](int i) {
+    // the reset lands while the loop holds its schedule
+    if (i == 0) {
+      RAJA::lws::reset_sticky_schedules();
+    }
+#pragma omp atomic
+    h[i]++;
+  };
+  auto key = RAJA::lws::make_tuning_key(body, len);
+
+  RAJA::lws::reset_sticky_schedules();
+  RAJA::forall<RAJA::omp_lws_sticky<100>>(RAJA::RangeSegment(0, len), body);
+  checkEachIndexOnce(hits);
+
+  auto info = RAJA::lws::get_sticky_info(key);
+  ASSERT_EQ(1, info.recordings);
+  ASSERT_FALSE(info.recorded);
+  RAJA::lws::reset_sticky_schedules();
+}
+
+TEST(LwsTest, StickyReschedulesOnImbalance)
+{
+  const int len = 2000;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+  int phase = 0;
+  const int* p = &phase;
+  auto body = [=](int i) {
+    // after the first run, the iterations recorded for thread 0 get slow
+    volatile double x = 0.0;
+    for (int k = 0; k < (*p && i < len / 8 ? 20000 : 1); ++k) {
+      x = x + k;
+    }
+#pragma omp atomic
+    h[i]++;
+  };
+  auto key = RAJA::lws::make_tuning_key(body, len);
+
+  RAJA::lws::reset_sticky_schedules();
+  setStaticFraction(0.5f, 4);
+  RAJA::forall<RAJA::omp_lws_sticky<5>>(RAJA::RangeSegment(0, len), body);
+  phase = 1;
+  for (int rep = 1; rep < 6; ++rep) {
+    RAJA::forall<RAJA::omp_lws_sticky<5>>(RAJA::RangeSegment(0, len), body);
+  }
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(6, hits[i]);
+  }
+
+  auto info = RAJA::lws::get_sticky_info(key);
+  ASSERT_EQ(6, info.recordings + info.replays);
+  if (omp_get_max_threads() > 1) {
+    ASSERT_GT(info.recordings, 1);
+  }
+  RAJA::lws::reset_sticky_schedules();
+}
+
+TEST(LwsTest, Stats)
+{
+  const int len = 20000;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+
+  RAJA::lws::reset_stats();
+  setStaticFraction(0.0f, 10);
+  RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+    h[i]++;
+  });
+  checkEachIndexOnce(hits);
+
+  RAJA::lws::stats s = RAJA::lws::get_stats();
+  if (RAJA::lws::stats_enabled) {
+    // the loop is fully dynamic, so every chunk was dequeued; the last
+    // chunk of each thread's share and a chunk split by each steal can be
+    // short
+    ASSERT_GE(s.chunks, static_cast<unsigned long long>(len / 10));
+    ASSERT_LE(s.chunks,
+              static_cast<unsigned long long>(len / 10 + omp_get_max_threads())
+                  + s.stolen);
+    ASSERT_LE(s.stolen, s.chunks);
+    ASSERT_GT(s.dequeueTime, 0.0);
+    ASSERT_GT(s.bodyTime, 0.0);
+  } else {
+    ASSERT_EQ(0u, s.chunks);
+    ASSERT_EQ(0u, s.stolen);
+    ASSERT_EQ(0u, s.failedSteals);
+    ASSERT_EQ(0.0, s.dequeueTime);
+    ASSERT_EQ(0.0, s.bodyTime);
+  }
+
+  RAJA::lws::reset_stats();
+  s = RAJA::lws::get_stats();
+  ASSERT_EQ(0u, s.chunks);
+  ASSERT_EQ(0.0, s.bodyTime);
+}
+
+TEST(LwsTest, WallTime)
+{
+  double t0 = vSched_get_wtime();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  double t1 = vSched_get_wtime();
+
+  // wall time, so the sleep counts
+  EXPECT_GT(t1 - t0, 0.015);
+  EXPECT_LT(t1 - t0, 0.5);
+}
+
+TEST(LwsTest, HierarchicalStealingOrder)
+{
+  // two sockets with two cache groups of two CPUs each
+  ASSERT_EQ(0, vSched_set_topology("0:0 0:0 0:1 0:1 1:0 1:0 1:1 1:1"));
+  ASSERT_EQ(-1, vSched_set_topology("0:0 0:x"));
+  setStealStrategy(VSCHED_VICTIM_HIERARCHICAL, 0);
+  setCrossSocketThreshold(20);
+
+  const int numThreads = 8;
+  const int len = 800;  // 100 iterations, 10 chunks of 10 per thread
+  vSched_context* ctx = vSched_context_acquire(numThreads);
+  ASSERT_NE(nullptr, ctx);
+  vSched_context_set_static_fraction(ctx, 0.0f, 10);
+
+  std::vector<int> hits(len, 0);
+  int start, end;
+  for (int t = 0; t < numThreads; ++t) {
+    loop_start_statdynstaggered_ctx(ctx, 0, len, &start, &end, t, numThreads);
+    ASSERT_EQ(start, end);
+  }
+
+  // thread 0 runs its own queue, then steals from its cache group, then
+  // from its socket, and never from the other socket, whose threads have
+  // fewer than 20 chunks left
+  std::vector<int> owners;
+  while (loop_next_statdynstaggered_ctx(ctx, &start, &end, 0)) {
+    owners.push_back(start / 100);
+    for (int i = start; i < end; ++i) {
+      hits[i]++;
+    }
+  }
+  ASSERT_EQ(40u, owners.size());
+  for (int c = 0; c < 40; ++c) {
+    if (c < 20) {
+      ASSERT_EQ(c / 10, owners[c]) << "chunk " << c;
+    } else {
+      ASSERT_TRUE(owners[c] == 2 || owners[c] == 3) << "chunk " << c;
+    }
+  }
+
+  for (int t = 1; t < numThreads; ++t) {
+    while (loop_next_statdynstaggered_ctx(ctx, &start, &end, t)) {
+      for (int i = start; i < end; ++i) {
+        hits[i]++;
+      }
+    }
+  }
+  checkEachIndexOnce(hits);
+  vSched_context_release(ctx);
+
+  setCrossSocketThreshold(4);
+  setStealStrategy(VSCHED_VICTIM_RANDOM, 0);
+  ASSERT_EQ(0, vSched_set_topology(nullptr));
+}
+
+TEST(LwsTest, HierarchicalStealingCoversRange)
+{
+  ASSERT_EQ(0, vSched_set_topology("0:0 0:0 0:1 0:1 1:0 1:0 1:1 1:1"));
+  setStealStrategy(VSCHED_VICTIM_HIERARCHICAL, 1);
+  setStaticFraction(0.25f, 3);
+
+  for (int threshold : {-1, 0, 4}) {
+    setCrossSocketThreshold(threshold);
+    const int len = 10007;
+    std::vector<int> hits(len, 0);
+    int* h = hits.data();
+    RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int i) {
+      volatile double x = 0.0;
+      for (int k = 0; k < (omp_get_thread_num() == 0 ? 50 : 1); ++k) {
+        x = x + k;
+      }
+#pragma omp atomic
+      h[i]++;
+    });
+    checkEachIndexOnce(hits);
+  }
+
+  setCrossSocketThreshold(4);
+  setStealStrategy(VSCHED_VICTIM_RANDOM, 0);
+  ASSERT_EQ(0, vSched_set_topology(nullptr));
+}
+
+TEST(LwsTest, SegmentIterationCoversUnevenSegments)
+{
+  // one long range, many short ranges, and list segments between them
+  RAJA::TypedIndexSet<RAJA::RangeSegment, RAJA::ListSegment> iset;
+  iset.push_back(RAJA::RangeSegment(0, 20000));
+  int next = 20000;
+  for (int s = 0; s < 40; ++s) {
+    iset.push_back(RAJA::RangeSegment(next, next + s));
+    next += s;
+    std::vector<RAJA::Index_type> list{next + 2, next, next + 1};
+    iset.push_back(RAJA::ListSegment(list.data(), list.size()));
+    next += 3;
+  }
+  const int len = next;
+
+  for (float fraction : {0.0f, 0.5f, 1.0f}) {
+    setStaticFraction(fraction, 7);
+    std::vector<int> hits(len, 0);
+    int* h = hits.data();
+    RAJA::forall<RAJA::ExecPolicy<RAJA::omp_lws_segit, RAJA::seq_exec>>(
+        iset, [=](RAJA::Index_type i) {
+#pragma omp atomic
+          h[i]++;
+        });
+    checkEachIndexOnce(hits);
+  }
+}
+
+TEST(LwsTest, SegmentIterationSplitsLongRange)
+{
+  // a single segment is still shared by the whole team
+  RAJA::TypedIndexSet<RAJA::RangeSegment> iset;
+  iset.push_back(RAJA::RangeSegment(0, 10000));
+  std::vector<int> owner(10000, -1);
+  int* o = owner.data();
+  setStaticFraction(0.5f, 16);
+  RAJA::forall<RAJA::ExecPolicy<RAJA::omp_lws_segit, RAJA::seq_exec>>(
+      iset, [=](RAJA::Index_type i) { o[i] = omp_get_thread_num(); });
+
+  std::vector<int> ran(omp_get_max_threads(), 0);
+  for (int t : owner) {
+    ASSERT_GE(t, 0);
+    ran[t] = 1;
+  }
+  EXPECT_EQ(omp_get_max_threads(), std::count(ran.begin(), ran.end(), 1));
+}
+
+TEST(LwsTest, TeamLoopsSeeEarlierLoops)
+{
+  const int len = 4099;
+  std::vector<int> a(len, 0), b(len, 0);
+  int* pa = a.data();
+  int* pb = b.data();
+  setStaticFraction(0.25f, 5);
+
+  RAJA::region<RAJA::omp_lws_region>([=]() {
+    for (int step = 1; step <= 20; ++step) {
+      RAJA::forall<RAJA::omp_lws_team_exec>(
+          RAJA::RangeSegment(0, len), [=](int i) { pa[i] = step; });
+      // reads an element another thread may have written
+      RAJA::forall<RAJA::omp_lws_team_exec>(
+          RAJA::RangeSegment(0, len),
+          [=](int i) { pb[i] += pa[len - 1 - i]; });
+    }
+  });
+
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(210, b[i]) << "index " << i;
+  }
+}
+
+TEST(LwsTest, TeamLoopsSeeEarlierDependLoops)
+{
+  const int len = 4099;
+  std::vector<int> a(len, 0), b(len, 0);
+  int* pa = a.data();
+  int* pb = b.data();
+  setStaticFraction(0.25f, 5);
+
+  RAJA::region<RAJA::omp_lws_region>([=]() {
+    for (int step = 1; step <= 20; ++step) {
+      RAJA::forall<RAJA::omp_lws_team_depend_exec<1>>(
+          RAJA::RangeSegment(0, len), [=](int i) {
+            // uneven, so that threads leave the loop at different times
+            volatile double x = 0.0;
+            for (int k = 0; k < (i % 97 == 0 ? 2000 : 1); ++k) {
+              x = x + k;
+            }
+            pa[i] = step;
+          });
+      // declares no halo, so it waits for the whole loop before it
+      RAJA::forall<RAJA::omp_lws_team_exec>(
+          RAJA::RangeSegment(0, len),
+          [=](int i) { pb[i] += pa[len - 1 - i]; });
+    }
+  });
+
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(210, b[i]) << "index " << i;
+  }
+}
+
+TEST(LwsTest, TeamLoopsSeeEarlierNowaitLoops)
+{
+  const int len = 4099;
+  std::vector<int> a(len, 0), b(len, 0);
+  int* pa = a.data();
+  int* pb = b.data();
+  setStaticFraction(0.25f, 5);
+
+  RAJA::region<RAJA::omp_lws_region>([=]() {
+    for (int step = 1; step <= 20; ++step) {
+      RAJA::forall<RAJA::omp_lws_team_nowait_exec>(
+          RAJA::RangeSegment(0, len), [=](int i) {
+            volatile double x = 0.0;
+            for (int k = 0; k < (i % 97 == 0 ? 2000 : 1); ++k) {
+              x = x + k;
+            }
+            pa[i] = step;
+          });
+      RAJA::forall<RAJA::omp_lws_team_nowait_exec>(
+          RAJA::RangeSegment(0, len),
+          [=](int i) { pb[i] += pa[len - 1 - i]; });
+    }
+  });
+
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(210, b[i]) << "index " << i;
+  }
+}
+
+TEST(LwsTest, TeamNowaitLoopsCoverRange)
+{
+  const int len = 3001;
+  const int loops = 9;
+  std::vector<int> hits(loops * len, 0);
+  int* h = hits.data();
+  setStaticFraction(0.0f, 3);
+
+  RAJA::region<RAJA::omp_lws_region>([=]() {
+    for (int loop = 0; loop < loops; ++loop) {
+      int* hl = h + loop * len;
+      RAJA::forall<RAJA::omp_lws_team_nowait_exec>(
+          RAJA::RangeSegment(0, len), [=](int i) {
+            volatile double x = 0.0;
+            for (int k = 0; k < (omp_get_thread_num() == loop % 2 ? 20 : 1);
+                 ++k) {
+              x = x + k;
+            }
+#pragma omp atomic
+            hl[i]++;
+          });
+    }
+  });
+
+  checkEachIndexOnce(hits);
+}
+
+TEST(LwsTest, TeamDependLoopsSeeTheirNeighbors)
+{
+  const int len = 2053;
+  const int steps = 15;
+  std::vector<long> a(len, 0), b(len, 0);
+  long* pa = a.data();
+  long* pb = b.data();
+  setStaticFraction(0.25f, 3);
+
+  RAJA::region<RAJA::omp_lws_region>([=]() {
+    for (int step = 1; step <= steps; ++step) {
+      // pa[i] is read by the iterations i - 1 to i + 1 of the loop before
+      RAJA::forall<RAJA::omp_lws_team_depend_exec<1>>(
+          RAJA::RangeSegment(0, len), [=](int i) {
+            // uneven, so that threads leave the loop at different times
+            volatile double x = 0.0;
+            for (int k = 0; k < (i % 97 == 0 ? 2000 : 1); ++k) {
+              x = x + k;
+            }
+            pa[i] = pb[i] + step;
+          });
+      RAJA::forall<RAJA::omp_lws_team_depend_exec<1>>(
+          RAJA::RangeSegment(0, len), [=](int i) {
+            long sum = pa[i];
+            if (i > 0) sum += pa[i - 1];
+            if (i < len - 1) sum += pa[i + 1];
+            pb[i] = sum;
+          });
+    }
+  });
+
+  // the same steps, one loop at a time
+  std::vector<long> ea(len, 0), eb(len, 0);
+  for (int step = 1; step <= steps; ++step) {
+    for (int i = 0; i < len; ++i) {
+      ea[i] = eb[i] + step;
+    }
+    for (int i = 0; i < len; ++i) {
+      eb[i] = ea[i] + (i > 0 ? ea[i - 1] : 0) + (i < len - 1 ? ea[i + 1] : 0);
+    }
+  }
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(eb[i], b[i]) << "index " << i;
+  }
+}
+
+TEST(LwsTest, TeamDependLoopAfterNowaitLoop)
+{
+  const int len = 3001;
+  std::vector<int> a(len, 0), b(len, 0);
+  int* pa = a.data();
+  int* pb = b.data();
+
+  RAJA::region<RAJA::omp_lws_region>([=]() {
+    for (int step = 1; step <= 10; ++step) {
+      RAJA::forall<RAJA::omp_lws_team_nowait_exec>(
+          RAJA::RangeSegment(0, len), [=](int i) { pa[i] = step; });
+      // waits for the whole nowait loop, it reads any element
+      RAJA::forall<RAJA::omp_lws_team_depend_exec<>>(
+          RAJA::RangeSegment(0, len),
+          [=](int i) { pb[i] += pa[len - 1 - i]; });
+      RAJA::forall<RAJA::omp_lws_team_exec>(RAJA::RangeSegment(0, 0),
+                                            [=](int) {});
+    }
+  });
+
+  for (int i = 0; i < len; ++i) {
+    ASSERT_EQ(55, b[i]) << "index " << i;
+  }
+}
+
+TEST(LwsTest, TeamForallAsyncHandle)
+{
+  const int len = 5003;
+  std::vector<int> hits(len, 0);
+  std::atomic<int> missing{0};
+  int* h = hits.data();
+  std::atomic<int>* m = &missing;
+
+  RAJA::region<RAJA::omp_lws_region>([=]() {
+    auto done = RAJA::lws::forall_async<RAJA::omp_lws_team_nowait_exec>(
+        RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+          h[i]++;
+        });
+    done.wait();
+    ASSERT_TRUE(done.done());
+    for (int i = 0; i < len; ++i) {
+      int hit;
+#pragma omp atomic read
+      hit = h[i];
+      if (hit != 1) (*m)++;
+    }
+  });
+
+  ASSERT_EQ(0, missing.load());
+  checkEachIndexOnce(hits);
+
+  // outside a team region the loop is finished when forall_async returns
+  std::fill(hits.begin(), hits.end(), 0);
+  RAJA::region<RAJA::omp_parallel_region>([=]() {
+    auto done = RAJA::lws::forall_async<RAJA::omp_lws_team_depend_exec<>>(
+        RAJA::RangeSegment(0, len), [=](int i) {
+#pragma omp atomic
+          h[i]++;
+        });
+    ASSERT_TRUE(done.done());
+  });
+  checkEachIndexOnce(hits);
+}
+
+TEST(LwsTest, TeamLoopsOutsideTeamRegion)
+{
+  const int len = 1000;
+  std::vector<int> hits(2 * len, 0);
+  int* h = hits.data();
+
+  RAJA::region<RAJA::omp_parallel_region>([=]() {
+    RAJA::forall<RAJA::omp_lws_team_exec>(RAJA::RangeSegment(0, len),
+                                          [=](int i) {
+#pragma omp atomic
+                                            h[i]++;
+                                          });
+  });
+
+  // a parallel region nested in a team region is not the team
+  RAJA::region<RAJA::omp_lws_region>([=]() {
+#pragma omp master
+    RAJA::region<RAJA::omp_parallel_region>([=]() {
+      RAJA::forall<RAJA::omp_lws_team_nowait_exec>(
+          RAJA::RangeSegment(len, 2 * len), [=](int i) {
+#pragma omp atomic
+            h[i]++;
+          });
+    });
+  });
+
+  checkEachIndexOnce(hits);
+}
+
+TEST(LwsTest, NoiseScheduleIsSeeded)
+{
+  const RAJA::lws::noise_model periodic =
+      RAJA::lws::periodic_noise(1e-3, 5e-5, 7);
+  const RAJA::lws::noise_model random = RAJA::lws::random_noise(1e-3, 5e-5, 7);
+  const RAJA::lws::noise_model other = RAJA::lws::random_noise(1e-3, 5e-5, 8);
+
+  for (int tid = 0; tid < 4; ++tid) {
+    RAJA::lws::thread_noise p(periodic, tid), r1(random, tid),
+        r2(random, tid), o(other, tid);
+    int ticks = 0, differ = 0;
+    double total = 0.0;
+    for (int chunk = 0; chunk < 10000; ++chunk) {
+      // chunks of 0.1 ms: one periodic interruption every 10 of them
+      ticks += p.delay(1e-4) > 0.0;
+      const double d = r1.delay(1e-4);
+      ASSERT_EQ(d, r2.delay(1e-4));
+      differ += d != o.delay(1e-4);
+      total += d;
+    }
+    ASSERT_EQ(1000, ticks);
+    ASSERT_GT(differ, 0);
+    // about one interruption per ms of work over 1 s of work
+    ASSERT_NEAR(1000 * 5e-5, total, 200 * 5e-5);
+  }
+
+  RAJA::lws::thread_noise slow(RAJA::lws::slow_thread_noise(1, 3.0), 1),
+      fast(RAJA::lws::slow_thread_noise(1, 3.0), 0);
+  ASSERT_DOUBLE_EQ(2e-3, slow.delay(1e-3));
+  ASSERT_EQ(0.0, fast.delay(1e-3));
+}
+
+template <typename Strategy>
+static void checkNoisyLoop(const RAJA::lws::noise_model& noise)
+{
+  const int len = 20011;
+  std::vector<int> hits(len, 0);
+  int* h = hits.data();
+
+  const RAJA::lws::noise_report r =
+      RAJA::lws::forall_with_noise<Strategy>(noise,
+                                             0.5f,
+                                             16,
+                                             RAJA::RangeSegment(0, len),
+                                             [=](int i) {
+#pragma omp atomic
+                                               h[i]++;
+                                             });
+
+  checkEachIndexOnce(hits);
+  ASSERT_EQ(omp_get_max_threads(), r.threads);
+  ASSERT_GT(r.chunks, 0);
+  ASSERT_GE(r.steals, 0);
+  ASSERT_GE(r.delayed, 0.0);
+  ASSERT_LE(r.busy + r.delayed, r.makespan * r.threads * 1.001);
+  ASSERT_GE(r.idle, -1e-3 * r.makespan * r.threads);
+}
+
+TEST(LwsTest, NoisyLoopsCoverRange)
+{
+  const RAJA::lws::noise_model models[] = {
+      RAJA::lws::noise_model(),
+      RAJA::lws::periodic_noise(1e-5, 2e-6, 3),
+      RAJA::lws::random_noise(1e-5, 2e-6, 3),
+      RAJA::lws::slow_thread_noise(0, 4.0)};
+
+  for (const auto& noise : models) {
+    checkNoisyLoop<RAJA::lws::static_schedule>(noise);
+    checkNoisyLoop<RAJA::lws::static_fraction>(noise);
+    checkNoisyLoop<RAJA::lws::statdynstaggered>(noise);
+    checkNoisyLoop<RAJA::lws::guided>(noise);
+  }
+
+  // the noise is what delayed reports
+  const RAJA::lws::noise_report quiet =
+      RAJA::lws::forall_with_noise<RAJA::lws::statdynstaggered>(
+          RAJA::lws::noise_model(), 0.5f, 16, RAJA::RangeSegment(0, 100),
+          [=](int) {});
+  ASSERT_EQ(0.0, quiet.delayed);
+}
+
+static int weightedCost(int i) { return (i % 7 == 0) ? 100 : i % 3; }
+
+TEST(LwsTest, WeightedCoversRange)
+{
+  const int lengths[] = {0, 1, 13, 1000, 100003};
+
+  setStaticFraction(0.5f, 4);
+  for (int len : lengths) {
+    std::vector<int> cost(len), offsets(len + 1, 5), zero(len, 0);
+    for (int i = 0; i < len; ++i) {
+      cost[i] = weightedCost(i);
+      offsets[i + 1] = offsets[i] + cost[i];
+    }
+
+    std::vector<int> hits(len, 0);
+    int* h = hits.data();
+    auto body = [=](int i) {
+#pragma omp atomic
+      h[i]++;
+    };
+    RAJA::forall(RAJA::omp_lws_weighted<int>(
+                     RAJA::lws::iteration_costs(cost.data())),
+                 RAJA::RangeSegment(0, len),
+                 body);
+    checkEachIndexOnce(hits);
+
+    std::fill(hits.begin(), hits.end(), 0);
+    RAJA::forall(RAJA::omp_lws_weighted<int>(
+                     RAJA::lws::cost_prefix(offsets.data())),
+                 RAJA::RangeSegment(0, len),
+                 body);
+    checkEachIndexOnce(hits);
+
+    std::fill(hits.begin(), hits.end(), 0);
+    RAJA::forall(RAJA::omp_lws_weighted<int>(
+                     RAJA::lws::iteration_costs(zero.data())),
+                 RAJA::RangeSegment(0, len),
+                 body);
+    checkEachIndexOnce(hits);
+  }
+}
+
+TEST(LwsTest, WeightedBalancesStaticPart)
+{
+  // the first tenth of the iterations costs as much as the rest nine times
+  const int len = 10000;
+  std::vector<double> cost(len);
+  for (int i = 0; i < len; ++i) {
+    cost[i] = (i < len / 10) ? 81.0 : 1.0;
+  }
+  const double total = 81.0 * (len / 10) + (len - len / 10);
+
+  const int maxThreads = omp_get_max_threads();
+  std::vector<double> threadCost(maxThreads, 0.0);
+  double* tc = threadCost.data();
+  const double* c = cost.data();
+
+  // no dynamic part, so the split is the static one
+  setStaticFraction(1.0f, 1);
+  RAJA::forall(RAJA::omp_lws_weighted<double>(
+                   RAJA::lws::iteration_costs(cost.data())),
+               RAJA::RangeSegment(0, len),
+               [=](int i) { tc[omp_get_thread_num()] += c[i]; });
+
+  // a thread's share is off by less than one iteration at either end
+  for (int t = 0; t < maxThreads; ++t) {
+    ASSERT_NEAR(total / maxThreads, threadCost[t], 2 * 81.0) << "thread " << t;
+  }
+}
+
+// each loop of the trace covers [0, len) once, in chunks of its own threads
+static void checkTracedLoops(const std::vector<RAJA::lws::trace_event>& events,
+                             int len,
+                             size_t loops)
+{
+  std::map<std::pair<long, int>, std::vector<int>> hits;
+  for (const auto& e : events) {
+    auto& h = hits[std::make_pair(e.loop, e.step)];
+    h.resize(len, 0);
+    ASSERT_LE(0, e.begin);
+    ASSERT_LT(e.begin, e.end);
+    ASSERT_LE(e.end, len);
+    ASSERT_LE(e.start, e.stop);
+    ASSERT_GE(e.stolen_from, -1);
+    ASSERT_NE(e.thread, e.stolen_from);
+    for (int i = e.begin; i < e.end; ++i) {
+      h[i]++;
+    }
+  }
+  ASSERT_EQ(loops, hits.size());
+  for (const auto& loop : hits) {
+    ASSERT_GT(loop.first.first, 0);
+    checkEachIndexOnce(loop.second);
+  }
+}
+
+TEST(LwsTest, TraceRecordsChunks)
+{
+  const int len = 10007;
+  RAJA::lws::clear_trace();
+  setStaticFraction(0.5f, 16);
+
+  RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int) {});
+  RAJA::forall<RAJA::omp_parallel_for_exec>(RAJA::RangeSegment(0, len),
+                                            [=](int) {});
+  RAJA::forall<RAJA::omp_parallel_for_static<7>>(RAJA::RangeSegment(0, len),
+                                                 [=](int) {});
+  RAJA::region<RAJA::omp_parallel_region>([=]() {
+    RAJA::forall<RAJA::omp_for_exec>(RAJA::RangeSegment(0, len), [=](int) {});
+    RAJA::forall<RAJA::omp_lws_for_exec>(RAJA::RangeSegment(0, len),
+                                         [=](int) {});
+  });
+  RAJA::region<RAJA::omp_lws_region>([=]() {
+    RAJA::forall<RAJA::omp_lws_team_exec>(RAJA::RangeSegment(0, len),
+                                          [=](int) {});
+    RAJA::forall<RAJA::omp_lws_team_nowait_exec>(RAJA::RangeSegment(0, len),
+                                                 [=](int) {});
+    RAJA::forall<RAJA::omp_lws_team_depend_exec<1>>(
+        RAJA::RangeSegment(0, len), [=](int) {});
+  });
+
+  const std::vector<RAJA::lws::trace_event> events = RAJA::lws::get_trace();
+  std::ostringstream json;
+  RAJA::lws::write_trace(json);
+  ASSERT_EQ(0u, json.str().find("{\"displayTimeUnit\":\"ns\""));
+
+  if (!RAJA::lws::trace_enabled) {
+    ASSERT_TRUE(events.empty());
+    return;
+  }
+
+  ASSERT_EQ(0, RAJA::lws::trace_dropped());
+  checkTracedLoops(events, len, 8);
+  size_t chunks = 0;
+  for (size_t at = json.str().find("\"ph\":\"X\""); at != std::string::npos;
+       at = json.str().find("\"ph\":\"X\"", at + 1)) {
+    ++chunks;
+  }
+  ASSERT_EQ(events.size(), chunks);
+
+  // nothing is recorded while tracing is off, and clear_trace empties it
+  RAJA::lws::set_tracing(false);
+  RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int) {});
+  RAJA::lws::set_tracing(true);
+  ASSERT_EQ(events.size(), RAJA::lws::get_trace().size());
+  RAJA::lws::clear_trace();
+  ASSERT_TRUE(RAJA::lws::get_trace().empty());
+}
+
+TEST(LwsTest, TraceAddsNoBarrier)
+{
+  const int threads = omp_get_max_threads();
+  std::atomic<int> passed(0);
+  std::atomic<int> timedOut(0);
+  std::atomic<int>* p = &passed;
+  std::atomic<int>* t = &timedOut;
+  // the other threads only start the nowait loop once thread 0 is past it,
+  // so a barrier in the loop would hold every thread until they give up
+  RAJA::region<RAJA::omp_parallel_region>([=]() {
+    if (omp_get_thread_num() != 0) {
+      const auto deadline =
+          std::chrono::steady_clock::now() + std::chrono::seconds(2);
+      while (p->load() == 0) {
+        if (std::chrono::steady_clock::now() > deadline) {
+          ++*t;
+          break;
+        }
+        std::this_thread::yield();
+      }
+    }
+    RAJA::forall<RAJA::omp_for_nowait_exec>(RAJA::RangeSegment(0, threads),
+                                            [=](int) {});
+    if (omp_get_thread_num() == 0) {
+      p->store(1);
+    }
+  });
+  ASSERT_EQ(0, timedOut.load());
+}
+
+TEST(LwsTest, TraceRecordsSteals)
+{
+  if (!RAJA::lws::trace_enabled) {
+    return;
+  }
+  const int len = 4096;
+  const int threads = omp_get_max_threads();
+  std::vector<std::atomic<int>> started(threads);
+  for (auto& s : started) {
+    s.store(0);
+  }
+  std::atomic<int> running(0);
+  std::atomic<int>* st = started.data();
+  std::atomic<int>* r = &running;
+  RAJA::lws::clear_trace();
+  setStaticFraction(0.0f, 4);
+  // once every thread has published its queue, thread 0 is slow, so the
+  // others steal from it
+  RAJA::forall<RAJA::omp_lws>(RAJA::RangeSegment(0, len), [=](int) {
+    const int t = omp_get_thread_num();
+    if (st[t].exchange(1) == 0) {
+      ++*r;
+      while (r->load() < threads) {
+        std::this_thread::yield();
+      }
+    }
+    if (t == 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(20));
+    }
+  });
+  const std::vector<RAJA::lws::trace_event> events = RAJA::lws::get_trace();
+  checkTracedLoops(events, len, 1);
+  if (threads > 1) {
+    ASSERT_TRUE(std::any_of(events.begin(),
+                            events.end(),
+                            [](const RAJA::lws::trace_event& e) {
+                              return e.stolen_from >= 0;
+                            }));
+  }
+  RAJA::lws::clear_trace();
+}
+
+#endif
@@ -42,7 +42,8 @@ using TestingTypes = ::testing::
 #if defined (RAJA_ENABLE_OPENMP)
   
   ,std::tuple<ExecPolicy<omp_parallel_for_segit, loop_exec>, omp_reduce>
-  ,std::tuple<ExecPolicy<omp_parallel_for_segit, loop_exec>,omp_reduce_ordered>              
+  ,std::tuple<ExecPolicy<omp_parallel_for_segit, loop_exec>,omp_reduce_ordered>
+  ,std::tuple<ExecPolicy<omp_parallel_for_segit, loop_exec>,omp_reduce_reproducible>              
 #endif
 #if defined (RAJA_ENABLE_TBB)
           ,std::tuple<ExecPolicy<seq_segit, tbb_for_exec>, tbb_reduce>
@@ -23,7 +23,11 @@
 #include "RAJA/RAJA.hpp"
 #include "RAJA/internal/MemUtils_CPU.hpp"
 
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <tuple>
+#include <vector>
 
 template <typename T>
 class ReductionConstructorTest : public ::testing::Test
@@ -99,7 +103,16 @@ using constructor_types =
                      std::tuple<RAJA::omp_reduce, double>,
                      std::tuple<RAJA::omp_reduce_ordered, int>,
                      std::tuple<RAJA::omp_reduce_ordered, float>,
-                     std::tuple<RAJA::omp_reduce_ordered, double>
+                     std::tuple<RAJA::omp_reduce_ordered, double>,
+                     std::tuple<RAJA::omp_reduce_reproducible, int>,
+                     std::tuple<RAJA::omp_reduce_reproducible, float>,
+                     std::tuple<RAJA::omp_reduce_reproducible, double>
+#endif
+#if defined(RAJA_ENABLE_LWS_THREADS)
+                     ,
+                     std::tuple<RAJA::lws_reduce, int>,
+                     std::tuple<RAJA::lws_reduce, float>,
+                     std::tuple<RAJA::lws_reduce, double>
 #endif
                      >;
 
@@ -364,20 +377,412 @@ REGISTER_TYPED_TEST_CASE_P(ReductionCorrectnessTest,
 
 using types = ::testing::Types<
     std::tuple<RAJA::seq_exec, RAJA::seq_reduce>,
-    std::tuple<RAJA::loop_exec, RAJA::seq_reduce>
+    std::tuple<RAJA::loop_exec, RAJA::seq_reduce>,
+    std::tuple<RAJA::simd_lanes_exec<>, RAJA::seq_reduce>,
+    std::tuple<RAJA::simd_lanes_exec<5>, RAJA::seq_reduce>
 #if defined(RAJA_ENABLE_OPENMP)
     ,
     std::tuple<RAJA::omp_parallel_for_exec, RAJA::omp_reduce>,
-    std::tuple<RAJA::omp_parallel_for_exec, RAJA::omp_reduce_ordered>
+    std::tuple<RAJA::omp_parallel_for_exec, RAJA::omp_reduce_ordered>,
+    std::tuple<RAJA::omp_lws, RAJA::omp_reduce>,
+    std::tuple<RAJA::omp_parallel_for_exec, RAJA::omp_reduce_reproducible>,
+    std::tuple<RAJA::omp_lws, RAJA::omp_reduce_reproducible>
 #endif
 #if defined(RAJA_ENABLE_TBB)
     ,
     std::tuple<RAJA::tbb_for_exec, RAJA::tbb_reduce>
+#endif
+#if defined(RAJA_ENABLE_LWS_THREADS)
+    ,
+    std::tuple<RAJA::lws_exec, RAJA::lws_reduce>
 #endif
     >;
 
 INSTANTIATE_TYPED_TEST_CASE_P(Reduce, ReductionCorrectnessTest, types);
 
+template <typename TUPLE>
+class ReductionTupleTest : public ReductionCorrectnessTest<TUPLE>
+{
+};
+TYPED_TEST_CASE_P(ReductionTupleTest);
+
+TYPED_TEST_P(ReductionTupleTest, ReduceTuple)
+{
+  using ExecPolicy = typename std::tuple_element<0, TypeParam>::type;
+  using ReducePolicy = typename std::tuple_element<1, TypeParam>::type;
+
+  RAJA::ReduceTuple<ReducePolicy,
+                    RAJA::reduce::sum<double>,
+                    RAJA::reduce::min<double>,
+                    RAJA::reduce::max<double>,
+                    RAJA::reduce::minloc<double>,
+                    RAJA::reduce::maxloc<double>,
+                    RAJA::reduce::sum<int>>
+      reducer(0.0, 1024.0, 0.0, {1024.0, 0}, {0.0, 0}, 0);
+
+  for (int rep = 1; rep <= 2; ++rep) {
+    RAJA::forall<ExecPolicy>(RAJA::RangeSegment(0, this->array_length),
+                             [=](int i) {
+                               const double v = this->array[i];
+                               reducer.template reduce<0>(v);
+                               reducer.template reduce<1>(v);
+                               reducer.template reduce<2>(v);
+                               reducer.template reduce<3>(v, i);
+                               reducer.template reduce<4>(v, i);
+                               reducer.template reduce<5>(1);
+                             });
+
+    ASSERT_FLOAT_EQ(rep * this->sum, reducer.template get<0>());
+    ASSERT_FLOAT_EQ(this->min, reducer.template get<1>());
+    ASSERT_FLOAT_EQ(this->max, reducer.template get<2>());
+    ASSERT_FLOAT_EQ(this->min, reducer.template get<3>());
+    ASSERT_EQ(this->minloc, reducer.template get<3>().getLoc());
+    ASSERT_FLOAT_EQ(this->max, reducer.template get<4>());
+    ASSERT_EQ(this->maxloc, reducer.template get<4>().getLoc());
+    ASSERT_EQ(rep * this->array_length, reducer.template get<5>());
+  }
+}
+
+TYPED_TEST_P(ReductionTupleTest, ReduceTupleDefault)
+{
+  using ReducePolicy = typename std::tuple_element<1, TypeParam>::type;
+
+  RAJA::ReduceTuple<ReducePolicy,
+                    RAJA::reduce::sum<int>,
+                    RAJA::reduce::min<double>,
+                    RAJA::reduce::maxloc<int>>
+      reducer;
+
+  ASSERT_EQ(0, reducer.template get<0>());
+  ASSERT_EQ(std::numeric_limits<double>::max(), reducer.template get<1>());
+  ASSERT_EQ(std::numeric_limits<int>::lowest(), reducer.template get<2>());
+  ASSERT_EQ(-1, reducer.template get<2>().getLoc());
+}
+
+REGISTER_TYPED_TEST_CASE_P(ReductionTupleTest,
+                           ReduceTuple,
+                           ReduceTupleDefault);
+
+// omp_reduce_reproducible has no ReduceTuple
+using tuple_types = ::testing::Types<
+    std::tuple<RAJA::seq_exec, RAJA::seq_reduce>,
+    std::tuple<RAJA::simd_lanes_exec<>, RAJA::seq_reduce>
+#if defined(RAJA_ENABLE_OPENMP)
+    ,
+    std::tuple<RAJA::omp_parallel_for_exec, RAJA::omp_reduce>,
+    std::tuple<RAJA::omp_parallel_for_exec, RAJA::omp_reduce_ordered>,
+    std::tuple<RAJA::omp_lws, RAJA::omp_reduce>
+#endif
+#if defined(RAJA_ENABLE_TBB)
+    ,
+    std::tuple<RAJA::tbb_for_exec, RAJA::tbb_reduce>
+#endif
+    >;
+
+INSTANTIATE_TYPED_TEST_CASE_P(Reduce, ReductionTupleTest, tuple_types);
+
+template <typename TUPLE>
+class ReductionArrayTest : public ::testing::Test
+{
+};
+TYPED_TEST_CASE_P(ReductionArrayTest);
+
+TYPED_TEST_P(ReductionArrayTest, Histogram)
+{
+  using ExecPolicy = typename std::tuple_element<0, TypeParam>::type;
+  using ReducePolicy = typename std::tuple_element<1, TypeParam>::type;
+
+  const int len = 10000;
+  const int bins = 37;
+  RAJA::ReduceArray<ReducePolicy, int> counts(bins);
+  RAJA::ReduceArray<ReducePolicy, double> weights(bins, 0.5);
+
+  ASSERT_EQ(bins, counts.size());
+  for (int rep = 1; rep <= 2; ++rep) {
+    RAJA::forall<ExecPolicy>(RAJA::RangeSegment(0, len), [=](int i) {
+      counts.add(i % bins, 1);
+      weights.add(i % bins, 0.25);
+    });
+
+    const std::vector<int> all = counts.get();
+    ASSERT_EQ(static_cast<size_t>(bins), all.size());
+    for (int b = 0; b < bins; ++b) {
+      const int expected = rep * (len / bins + (b < len % bins ? 1 : 0));
+      ASSERT_EQ(expected, all[b]);
+      ASSERT_EQ(expected, counts.get(b));
+      ASSERT_DOUBLE_EQ(0.5 + 0.25 * expected, weights.get(b));
+    }
+  }
+
+  counts.reset(3);
+  RAJA::forall<ExecPolicy>(RAJA::RangeSegment(0, len),
+                           [=](int) { counts.add(0, 1); });
+  ASSERT_EQ(3 + len, counts.get(0));
+  ASSERT_EQ(3, counts.get(bins - 1));
+}
+
+TYPED_TEST_P(ReductionArrayTest, ManySparseBins)
+{
+  using ExecPolicy = typename std::tuple_element<0, TypeParam>::type;
+  using ReducePolicy = typename std::tuple_element<1, TypeParam>::type;
+
+  // far more bins than iterations, and bins that all of them add to; the
+  // other bins are each added to once, spread over most of the range
+  const int len = 10000;
+  const int bins = 1 << 20;
+  const int hot = bins / 2 + 3;
+  RAJA::ReduceArray<ReducePolicy, long> counts(bins);
+
+  RAJA::forall<ExecPolicy>(RAJA::RangeSegment(0, len),
+                           [=](RAJA::Index_type i) {
+                             counts.add((i % 1000) * 1000 + i / 1000, i);
+                             counts.add(hot, 1);
+                             counts.add(bins - 1, 2);
+                           });
+
+  const std::vector<long> all = counts.get();
+  long total = 0;
+  for (long c : all) {
+    total += c;
+  }
+  ASSERT_EQ(static_cast<long>(len) * (len - 1) / 2 + 3L * len, total);
+  ASSERT_EQ(len, counts.get(hot));
+  ASSERT_EQ(2L * len, counts.get(bins - 1));
+  ASSERT_EQ(5, counts.get(5000));
+  ASSERT_EQ(9999, counts.get(999009));
+  ASSERT_EQ(0, counts.get(999));
+}
+
+REGISTER_TYPED_TEST_CASE_P(ReductionArrayTest, Histogram, ManySparseBins);
+
+using array_types = ::testing::Types<
+    std::tuple<RAJA::seq_exec, RAJA::seq_reduce>,
+    std::tuple<RAJA::simd_lanes_exec<>, RAJA::seq_reduce>
+#if defined(RAJA_ENABLE_OPENMP)
+    ,
+    std::tuple<RAJA::omp_parallel_for_exec, RAJA::omp_reduce>,
+    std::tuple<RAJA::omp_lws, RAJA::omp_reduce>
+#endif
+#if defined(RAJA_ENABLE_LWS_THREADS)
+    ,
+    std::tuple<RAJA::lws_exec, RAJA::lws_reduce>
+#endif
+    >;
+
+INSTANTIATE_TYPED_TEST_CASE_P(Reduce, ReductionArrayTest, array_types);
+
+#if defined(RAJA_ENABLE_OPENMP)
+TEST(ReductionOMPTest, TeamLargerThanWhenMade)
+{
+  const int len = 10000;
+  const int outer = omp_get_max_threads();
+  omp_set_num_threads(1);
+  RAJA::ReduceSum<RAJA::omp_reduce, long> sum(0);
+  RAJA::ReduceMaxLoc<RAJA::omp_reduce, int> maxloc(-1, -1);
+  // more threads than the reducers have slots for
+  omp_set_num_threads(outer + 3);
+  RAJA::forall<RAJA::omp_parallel_for_exec>(RAJA::RangeSegment(0, len),
+                                            [=](int i) {
+                                              sum += i;
+                                              maxloc.maxloc(i % 1000, i);
+                                            });
+  omp_set_num_threads(outer);
+
+  ASSERT_EQ(static_cast<long>(len) * (len - 1) / 2, sum.get());
+  ASSERT_EQ(999, maxloc.get());
+  ASSERT_EQ(999, maxloc.getLoc() % 1000);
+}
+
+TEST(ReductionOMPTest, NestedRegions)
+{
+  const int saved = omp_get_max_active_levels();
+  omp_set_max_active_levels(2);
+  RAJA::ReduceSum<RAJA::omp_reduce, long> sum(0);
+  RAJA::ReduceMin<RAJA::omp_reduce, int> min(100);
+
+  // the teams of the inner loops have the same thread numbers
+#pragma omp parallel num_threads(2)
+  {
+    const int offset = 1000 * omp_get_thread_num();
+    RAJA::forall<RAJA::omp_parallel_for_exec>(RAJA::RangeSegment(0, 1000),
+                                              [=](int i) {
+                                                sum += offset + i;
+                                                min.min(offset - i);
+                                              });
+  }
+  omp_set_max_active_levels(saved);
+
+  ASSERT_EQ(1999L * 2000 / 2, sum.get());
+  ASSERT_EQ(-999, min.get());
+}
+
+TEST(ReductionOMPTest, GetAndResetBetweenLoops)
+{
+  RAJA::ReduceSum<RAJA::omp_reduce, long> a(0), b(10), c(0), d(0);
+
+  for (int rep = 1; rep <= 3; ++rep) {
+    RAJA::forall<RAJA::omp_parallel_for_exec>(RAJA::RangeSegment(0, 1000),
+                                              [=](int i) {
+                                                a += 1;
+                                                b += 2;
+                                                c += i;
+                                                d += (i % 2) ? 1 : -1;
+                                              });
+    ASSERT_EQ(1000L * rep, a.get());
+    // get() twice gives the same value
+    ASSERT_EQ(10 + 2000L * rep, b.get());
+    ASSERT_EQ(10 + 2000L * rep, b.get());
+    ASSERT_EQ(499500L * rep, c.get());
+    ASSERT_EQ(0, d.get());
+  }
+
+  a.reset(5);
+  RAJA::forall<RAJA::omp_parallel_for_exec>(RAJA::RangeSegment(0, 1000),
+                                            [=](int) { a += 1; });
+  ASSERT_EQ(1005, a.get());
+}
+
+TEST(ReductionOMPTest, SimdLanesUnderParallelFor)
+{
+  using Pol = RAJA::KernelPolicy<RAJA::statement::For<
+      0,
+      RAJA::omp_parallel_for_exec,
+      RAJA::statement::For<1,
+                           RAJA::simd_lanes_exec<>,
+                           RAJA::statement::Lambda<0>>>>;
+  const int rows = 37, cols = 101;
+  RAJA::ReduceSum<RAJA::omp_reduce, long> sum(0);
+  RAJA::ReduceMaxLoc<RAJA::omp_reduce, int> maxloc(-1, -1);
+
+  RAJA::kernel<Pol>(RAJA::make_tuple(RAJA::RangeSegment(0, rows),
+                                     RAJA::RangeSegment(0, cols)),
+                    [=](int r, int c) {
+                      sum += r * cols + c;
+                      maxloc.maxloc((r * 7 + c) % 300, r * cols + c);
+                    });
+
+  const long n = rows * cols;
+  ASSERT_EQ(n * (n - 1) / 2, sum.get());
+  ASSERT_EQ(299, maxloc.get());
+  ASSERT_EQ(299, (maxloc.getLoc() / cols * 7 + maxloc.getLoc() % cols) % 300);
+}
+
+TEST(ReductionReproducibleTest, ExactSumRoundsOnce)
+{
+  using RAJA::reduce::detail::exact_sum;
+  const double big = std::ldexp(1.0, 53);
+
+  exact_sum a;
+  for (double x : {1e100, 1.0, -1e100, 1e-300}) {
+    a.add(x);
+  }
+  ASSERT_EQ(1.0, a.get());
+
+  // a tie rounds to even, anything above it rounds up
+  exact_sum b;
+  b.add(big);
+  b.add(1.0);
+  ASSERT_EQ(big, b.get());
+  b.add(std::ldexp(1.0, -1000));
+  ASSERT_EQ(big + 2.0, b.get());
+
+  exact_sum c;
+  c.add(-3.0);
+  c.add(std::numeric_limits<double>::denorm_min());
+  ASSERT_EQ(-3.0, c.get());
+  c.add(3.0);
+  ASSERT_EQ(std::numeric_limits<double>::denorm_min(), c.get());
+
+  exact_sum d;
+  d.add(std::numeric_limits<double>::max());
+  d.add(std::numeric_limits<double>::max());
+  ASSERT_EQ(std::numeric_limits<double>::infinity(), d.get());
+  d.add(-std::numeric_limits<double>::max());
+  ASSERT_EQ(std::numeric_limits<double>::max(), d.get());
+  d.add(-std::numeric_limits<double>::infinity());
+  ASSERT_EQ(-std::numeric_limits<double>::infinity(), d.get());
+  d.add(std::numeric_limits<double>::infinity());
+  ASSERT_TRUE(std::isnan(d.get()));
+
+  exact_sum e, f;
+  for (int i = 0; i < 1000; ++i) {
+    (i % 2 ? e : f).add(0.1 * i - 7.0);
+  }
+  e.add(f);
+  double serial = 0.0;
+  for (int i = 0; i < 1000; ++i) {
+    serial += 0.1 * i - 7.0;
+  }
+  ASSERT_NEAR(serial, e.get(), 1e-9);
+}
+
+template <typename POLICY>
+void reproducibleReductions(const std::vector<double>& x,
+                            double& sum,
+                            float& fsum,
+                            RAJA::Index_type& minloc,
+                            double& max)
+{
+  const double* v = x.data();
+  RAJA::ReduceSum<RAJA::omp_reduce_reproducible, double> s(0.0);
+  RAJA::ReduceSum<RAJA::omp_reduce_reproducible, float> fs(0.0f);
+  RAJA::ReduceMinLoc<RAJA::omp_reduce_reproducible, double> ml(1e300, -1);
+  RAJA::ReduceMax<RAJA::omp_reduce_reproducible, double> m(-1e300);
+  RAJA::forall<POLICY>(RAJA::RangeSegment(0, x.size()), [=](int i) {
+    s += v[i];
+    fs += static_cast<float>(v[i]);
+    // every value is tied, the lowest index wins
+    ml.minloc(1.0, i);
+    // 0.0 wins over -0.0
+    m.max(v[i] == 0.0 ? 0.0 : -0.0);
+  });
+  sum = s.get();
+  fsum = fs.get();
+  minloc = ml.getLoc();
+  max = m.get();
+}
+
+TEST(ReductionReproducibleTest, SameForAnyThreadCount)
+{
+  std::vector<double> x(20000);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = std::sin(i * 0.7) * std::pow(10.0, static_cast<int>(i % 31) - 15);
+  }
+  x[x.size() / 2] = 0.0;
+  x[x.size() / 3] = 0.0;
+
+  double sum0, max0;
+  float fsum0;
+  RAJA::Index_type minloc0;
+  reproducibleReductions<RAJA::seq_exec>(x, sum0, fsum0, minloc0, max0);
+  ASSERT_EQ(0, minloc0);
+  ASSERT_EQ(0.0, max0);
+  ASSERT_FALSE(std::signbit(max0));
+
+  const int outer = omp_get_max_threads();
+  for (int threads = 1; threads <= 5; ++threads) {
+    omp_set_num_threads(threads);
+    for (int rep = 0; rep < 3; ++rep) {
+      double sum, max;
+      float fsum;
+      RAJA::Index_type minloc;
+      if (rep == 0) {
+        reproducibleReductions<RAJA::omp_parallel_for_exec>(
+            x, sum, fsum, minloc, max);
+      } else {
+        setStaticFraction(rep == 1 ? 0.0f : 0.5f, 7);
+        reproducibleReductions<RAJA::omp_lws>(x, sum, fsum, minloc, max);
+      }
+      ASSERT_EQ(0, std::memcmp(&sum, &sum0, sizeof(sum)));
+      ASSERT_EQ(0, std::memcmp(&fsum, &fsum0, sizeof(fsum)));
+      ASSERT_EQ(minloc0, minloc);
+      ASSERT_EQ(0, std::memcmp(&max, &max0, sizeof(max)));
+    }
+  }
+  omp_set_num_threads(outer);
+}
+#endif
+
 template <typename TUPLE>
 class NestedReductionCorrectnessTest : public ::testing::Test
 {
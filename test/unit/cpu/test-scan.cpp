@@ -42,6 +42,9 @@ using ExecTypes = std::tuple<
 #if defined (RAJA_ENABLE_TBB)
     ,RAJA::tbb_for_exec
 #endif
+#if defined (RAJA_ENABLE_LWS_THREADS)
+    ,RAJA::lws_exec
+#endif
 >;
 
 using ReduceTypes = std::tuple<RAJA::operators::plus<int>,
@@ -1187,6 +1187,129 @@ TEST(Kernel, Collapse8)
   delete[] data;
 }
 
+TEST(Kernel, LwsCollapse2)
+{
+  // lengths that do not divide into tiles, and a short inner loop
+  for (int M : {1, 7, 100}) {
+    int N = 333;
+
+    int *data = new int[N*M];
+    for(int i = 0;i < M*N;++ i){
+      data[i] = 0;
+    }
+
+    using Pol = RAJA::KernelPolicy<
+        RAJA::statement::Collapse<RAJA::omp_lws_collapse_exec, ArgList<0, 1>,
+          Lambda<0>
+        > >;
+
+    RAJA::kernel<Pol>(
+        RAJA::make_tuple(
+            RAJA::RangeSegment(0, N),
+            RAJA::RangeSegment(0, M)),
+
+        [=] (Index_type i, Index_type j) {
+          // the first rows are much more expensive
+          volatile double x = 0.0;
+          for (int k = 0; k < (i < 10 ? 1000 : 1); ++k) {
+            x = x + k;
+          }
+          data[j + i*M] += 1;
+         });
+
+    for(int i = 0;i < N;++ i){
+      for(int j = 0;j < M;++ j){
+        ASSERT_EQ(data[j + i*M], 1);
+      }
+    }
+
+    delete[] data;
+  }
+}
+
+TEST(Kernel, LwsCollapse3)
+{
+  int N = 37;
+  int M = 5;
+  int K = 21;
+
+  int *data = new int[N*M*K];
+  for(int i = 0;i < M*N*K;++ i){
+    data[i] = -1;
+  }
+
+  using Pol = RAJA::KernelPolicy<
+      RAJA::statement::Collapse<RAJA::omp_lws_collapse_exec, ArgList<0, 1, 2>,
+       Lambda<0>
+        > >;
+
+  RAJA::kernel<Pol>(
+        RAJA::make_tuple(
+        RAJA::RangeSegment(0, K),
+        RAJA::RangeSegment(0, M),
+        RAJA::RangeSegment(0, N) ),
+        [=] (Index_type k, Index_type j, Index_type i) {
+          data[i + N*(j + M*k)] = i + N*(j+M*k);
+        });
+
+  for(int k=0; k<K; k++){
+    for(int j=0; j<M; ++j){
+      for(int i=0; i<N; ++i){
+        int id = i + N*(j + M*k);
+        ASSERT_EQ(data[id], id);
+      }
+    }
+  }
+
+  delete[] data;
+}
+
+TEST(Kernel, LwsCollapseNested)
+{
+
+  int N  = 3;
+  int M  = 30;
+  int K  = 4;
+  int P  = 50;
+
+  int *data = new int[N*M*K*P];
+  for(int i = 0; i< N*M*K*P; ++i){
+    data[i] = 0;
+  }
+
+  using Pol = RAJA::KernelPolicy<
+        For<0, RAJA::seq_exec,
+          RAJA::statement::Collapse<RAJA::omp_lws_collapse_exec, ArgList<1, 2>,
+            For<3, RAJA::seq_exec, Lambda<0> >
+          >
+        > >;
+
+  RAJA::kernel<Pol>(
+        RAJA::make_tuple(
+        RAJA::RangeSegment(0, K),
+        RAJA::RangeSegment(0, M),
+        RAJA::RangeSegment(0, N),
+        RAJA::RangeSegment(0, P)
+                         ),
+        [=] (Index_type k, Index_type j, Index_type i, Index_type r) {
+          Index_type id = r + P*(i + N*(j + M*k));
+          data[id] += id;
+        });
+
+  for(int k=0; k<K; ++k){
+    for(int j=0; j<M; ++j){
+      for(int i=0; i<N; ++i){
+        for(int r=0; r<P; ++r){
+          Index_type id = r + P*(i + N*(j + M*k));
+          ASSERT_EQ(data[id], id);
+        }
+      }
+    }
+  }
+
+  delete[] data;
+}
+
 #endif //RAJA_ENABLE_OPENMP
 
 #if defined(RAJA_ENABLE_CUDA)